@@ -80,6 +80,8 @@ set(GAMESHAREDLIST
     ${GAMELOGIC_DIR}/shared/parse.cpp
     ${GAMELOGIC_DIR}/shared/parse.h
     ${GAMELOGIC_DIR}/shared/Clustering.h
+    ${GAMELOGIC_DIR}/shared/TraceProfile.cpp
+    ${GAMELOGIC_DIR}/shared/TraceProfile.h
 
     ${GAMELOGIC_DIR}/shared/navgen/brush.cpp
     ${GAMELOGIC_DIR}/shared/navgen/nav.cpp
@@ -193,6 +195,8 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/BaseClustering.cpp
     ${GAMELOGIC_DIR}/sgame/Entities.cpp
     ${GAMELOGIC_DIR}/sgame/Entities.h
+    ${GAMELOGIC_DIR}/sgame/FrameProfile.cpp
+    ${GAMELOGIC_DIR}/sgame/FrameProfile.h
     ${GAMELOGIC_DIR}/sgame/sg_active.cpp
     ${GAMELOGIC_DIR}/sgame/sg_admin.cpp
     ${GAMELOGIC_DIR}/sgame/sg_admin.h
@@ -204,7 +208,10 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/sg_bot_nav.cpp
     ${GAMELOGIC_DIR}/sgame/sg_bot_parse.cpp
     ${GAMELOGIC_DIR}/sgame/sg_bot_parse.h
+    ${GAMELOGIC_DIR}/sgame/sg_bot_perception.cpp
+    ${GAMELOGIC_DIR}/sgame/sg_bot_program.cpp
     ${GAMELOGIC_DIR}/sgame/sg_bot_public.h
+    ${GAMELOGIC_DIR}/sgame/sg_bot_schedule.cpp
     ${GAMELOGIC_DIR}/sgame/sg_bot_skilltree.cpp
     ${GAMELOGIC_DIR}/sgame/sg_bot_util.cpp
     ${GAMELOGIC_DIR}/sgame/sg_bot_util.h
@@ -254,6 +261,7 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/CustomSurfaceFlags.h
 
     ${GAMELOGIC_DIR}/sgame/botlib/bot_api.h
+    ${GAMELOGIC_DIR}/sgame/botlib/bot_cluster.cpp
     ${GAMELOGIC_DIR}/sgame/botlib/bot_debug.cpp
     ${GAMELOGIC_DIR}/sgame/botlib/bot_convert.cpp
     ${GAMELOGIC_DIR}/sgame/botlib/bot_convert.h
@@ -262,6 +270,7 @@ set(SGAMELIST
     ${GAMELOGIC_DIR}/sgame/botlib/bot_local.h
     ${GAMELOGIC_DIR}/sgame/botlib/bot_nav.cpp
     ${GAMELOGIC_DIR}/sgame/botlib/bot_nav_edit.cpp
+    ${GAMELOGIC_DIR}/sgame/botlib/bot_route.cpp
     ${GAMELOGIC_DIR}/sgame/botlib/bot_navdraw.h
     ${GAMELOGIC_DIR}/sgame/botlib/bot_types.h
 
@@ -348,3 +357,12 @@ set(SGAMELIST
 
     ${GAMESHAREDLIST}
 )
+
+set(BENCHMARKLIST
+    ${GAMELOGIC_DIR}/benchmark/BenchmarkMap.cpp
+    ${GAMELOGIC_DIR}/benchmark/BenchmarkMap.h
+    ${GAMELOGIC_DIR}/benchmark/BenchmarkReplay.cpp
+    ${GAMELOGIC_DIR}/benchmark/BenchmarkReplay.h
+    ${GAMELOGIC_DIR}/benchmark/BenchmarkVM.cpp
+    ${GAMELOGIC_DIR}/benchmark/BenchmarkVM.h
+)
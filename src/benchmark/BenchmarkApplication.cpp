@@ -0,0 +1,256 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// BenchmarkApplication.cpp -- runs the sgame headless on a generated map,
+// replays a usercmd stream and reports the frame times. For example:
+//   sgame-benchmark -pakpath pkg -set benchmark.replay tools/sgame-benchmark/arena.replay
+
+#include "common/Common.h"
+#include "engine/framework/Application.h"
+#include "engine/framework/CommandSystem.h"
+
+#include "BenchmarkMap.h"
+#include "BenchmarkReplay.h"
+#include "BenchmarkVM.h"
+
+#include <chrono>
+#include <sstream>
+
+namespace Application {
+
+	using namespace Benchmark;
+
+	static Cvar::Cvar<std::string> replayFile( "benchmark.replay", "usercmd stream replayed by the benchmark", Cvar::NONE, "" );
+	static Cvar::Range<Cvar::Cvar<int>> frameMsec( "benchmark.frameMsec", "length of the server frames", Cvar::NONE, 25, 1, 1000 );
+
+	class BenchmarkApplication : public Application
+	{
+	public:
+		void Initialize() override
+		{
+			std::string error;
+
+			if ( replayFile.Get().empty() )
+			{
+				Sys::Error( "no replay given, set benchmark.replay" );
+			}
+
+			if ( !ParseReplay( FS::RawPath::OpenRead( replayFile.Get() ).ReadAll(), replay, error ) )
+			{
+				Sys::Error( "%s: %s", replayFile.Get(), error );
+			}
+
+			std::string entities = WritePackages();
+
+			Cvar::SetValue( "mapname", MAP_NAME );
+			Cvar::SetValue( "g_layouts", MAP_NAME );
+			// Measure everything the bots would like to do, not what the budget lets them.
+			Cvar::SetValue( "g_bot_thinkBudget", "0" );
+
+			for ( const auto& cvar : replay.cvars )
+			{
+				Cvar::SetValue( cvar.first, cvar.second );
+			}
+
+			vm.Start( std::move( entities ) );
+			vm.GameInit( levelTime, replay.seed );
+
+			// Let the map settle like the server does after loading it.
+			for ( int i = 0; i < 3; i++ )
+			{
+				levelTime += 100;
+				vm.RunFrame( levelTime );
+			}
+		}
+
+		void Frame() override
+		{
+			for ( const Step& step : replay.steps )
+			{
+				RunStep( step );
+			}
+
+			Report();
+			Sys::Quit( "benchmark done" );
+		}
+
+		void Shutdown( bool error, Str::StringRef ) override
+		{
+			if ( error )
+			{
+				vm.Free();
+			}
+			else
+			{
+				vm.Shutdown();
+			}
+		}
+
+	private:
+		// Generates the arena and the packages standing in for the assets
+		// which are not part of the repository, then loads the game packages.
+		std::string WritePackages()
+		{
+			const FS::PakInfo *game = FS::FindPak( "unvanquished" );
+
+			if ( !game )
+			{
+				Sys::Error( "the unvanquished package is missing, add the pkg directory with -pakpath" );
+			}
+
+			std::string pkgDir = FS::Path::Build( FS::GetHomePath(), "pkg" );
+			std::istringstream deps( FS::RawPath::OpenRead( FS::Path::Build( game->path, "DEPS" ) ).ReadAll() );
+			std::string name;
+
+			while ( deps >> name )
+			{
+				if ( !FS::FindPak( name ) )
+				{
+					FS::File file = FS::RawPath::OpenWrite( FS::Path::Build( pkgDir, Str::Format( "%s_0.dpkdir/DEPS", name ) ) );
+					file.Close();
+				}
+			}
+
+			std::string entities = WriteArena( FS::Path::Build( pkgDir, Str::Format( "%s_0.dpkdir", MAP_NAME ) ) );
+
+			FS::RefreshPaks();
+			FS::PakPath::LoadPak( *FS::FindPak( "unvanquished" ) );
+			FS::PakPath::LoadPak( *FS::FindPak( MAP_NAME ) );
+
+			return entities;
+		}
+
+		void RunStep( const Step& step )
+		{
+			std::string reason;
+
+			switch ( step.kind )
+			{
+			case Step::Kind::CONNECT:
+				if ( !vm.ClientConnect( step.client, step.text, reason ) )
+				{
+					Sys::Error( "client %d was denied: %s", step.client, reason );
+				}
+
+				vm.ClientBegin( step.client );
+				replayClients[ step.client ] = true;
+				break;
+
+			case Step::Kind::DISCONNECT:
+				vm.ClientDisconnect( step.client );
+				replayClients[ step.client ] = false;
+				break;
+
+			case Step::Kind::SERVER_COMMAND:
+				Cmd::BufferCommandText( step.text );
+				Cmd::ExecuteCommandBuffer();
+				break;
+
+			case Step::Kind::CLIENT_COMMAND:
+				vm.ClientCommand( step.client, step.text );
+				break;
+
+			case Step::Kind::MOVE:
+			{
+				usercmd_t& cmd = vm.Usercmd( step.client );
+				cmd.forwardmove = step.forward;
+				cmd.rightmove = step.right;
+				cmd.upmove = step.up;
+				cmd.angles[ PITCH ] = ANGLE2SHORT( step.pitch );
+				cmd.angles[ YAW ] = ANGLE2SHORT( step.yaw );
+				usercmdClearButtons( cmd.buttons );
+
+				for ( int button : step.buttons )
+				{
+					usercmdPressButton( cmd.buttons, button );
+				}
+
+				break;
+			}
+
+			case Step::Kind::RUN:
+				for ( int frame = 0; frame < step.frames; frame++ )
+				{
+					RunFrame();
+				}
+
+				break;
+			}
+		}
+
+		// One client packet per client and frame, then the game frame
+		void RunFrame()
+		{
+			levelTime += frameMsec.Get();
+
+			auto start = std::chrono::steady_clock::now();
+
+			for ( int clientNum = 0; clientNum < MAX_CLIENTS; clientNum++ )
+			{
+				if ( replayClients[ clientNum ] && vm.Connected( clientNum ) )
+				{
+					vm.Usercmd( clientNum ).serverTime = levelTime;
+					vm.ClientThink( clientNum );
+				}
+			}
+
+			vm.RunFrame( levelTime );
+
+			times.push_back( std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start ).count() );
+		}
+
+		void Report()
+		{
+			if ( times.empty() )
+			{
+				Sys::Error( "the replay did not run any frame" );
+			}
+
+			std::sort( times.begin(), times.end() );
+
+			int64_t total = 0;
+
+			for ( int64_t time : times )
+			{
+				total += time;
+			}
+
+			size_t p99 = std::max<size_t>( ( times.size() * 99 + 99 ) / 100, 1 ) - 1;
+
+			Log::Notice( "%s: %d frames of %dms: mean %.1fus, p99 %dus, max %dus",
+			             replayFile.Get(), int( times.size() ), frameMsec.Get(),
+			             total / float( times.size() ), times[ p99 ], times.back() );
+		}
+
+		GameVM vm;
+		Replay replay;
+		int levelTime = 0;
+		bool replayClients[ MAX_CLIENTS ] = {};
+		std::vector<int64_t> times;
+	};
+
+	INIT_APPLICATION( BenchmarkApplication );
+
+}
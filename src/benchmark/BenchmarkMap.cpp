@@ -0,0 +1,221 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "BenchmarkMap.h"
+
+#include "engine/qcommon/q_shared.h"
+#include "engine/qcommon/qfiles.h"
+
+namespace Benchmark {
+
+	// Inside of the box, the walls are WALL units thick around it
+	static const int ARENA_MINS[ 3 ] = { -1024, -1024, 0 };
+	static const int ARENA_MAXS[ 3 ] = { 1024, 1024, 512 };
+	static const int WALL = 16;
+
+	static const char ENTITIES[] =
+		"{\n"
+		"\"classname\" \"worldspawn\"\n"
+		"\"message\" \"sgame benchmark arena\"\n"
+		"}\n"
+		"{\n"
+		"\"classname\" \"info_player_deathmatch\"\n"
+		"\"origin\" \"0 0 64\"\n"
+		"}\n"
+		"{\n"
+		"\"classname\" \"info_player_intermission\"\n"
+		"\"origin\" \"0 0 256\"\n"
+		"\"angles\" \"45 0 0\"\n"
+		"}\n";
+
+	// name origin angles origin2 angles2, see G_LayoutLoad
+	static const char LAYOUT[] =
+		"telenode -768 0 64 0 0 0 0 0 1 0 0 0\n"
+		"reactor -896 256 64 0 0 0 0 0 1 0 0 0\n"
+		"mgturret -640 -256 64 0 0 0 0 0 1 0 0 0\n"
+		"eggpod 768 0 64 0 180 0 0 0 1 0 0 0\n"
+		"overmind 896 256 64 0 180 0 0 0 1 0 0 0\n"
+		"acid_tube 640 -256 64 0 180 0 0 0 1 0 0 0\n";
+
+	template<typename T>
+	static void AddLump( std::string& bsp, dheader_t& header, int lump, const T *data, size_t count )
+	{
+		header.lumps[ lump ].fileofs = bsp.size();
+		header.lumps[ lump ].filelen = sizeof( T ) * count;
+		bsp.append( reinterpret_cast<const char*>( data ), sizeof( T ) * count );
+
+		while ( bsp.size() % 4 )
+		{
+			bsp.push_back( '\0' );
+		}
+	}
+
+	/*
+	 * The six walls are axial brushes. The tree has a single node splitting
+	 * the box in two leaves, each referencing every brush: the collision code
+	 * only relies on the leaf brush lists, and with no visibility data every
+	 * leaf of cluster 0 sees every other one.
+	 */
+	static std::string BuildBSP()
+	{
+		std::vector<dshader_t> shaders( 1 );
+		Q_strncpyz( shaders[ 0 ].shader, "textures/common/caulk", sizeof( shaders[ 0 ].shader ) );
+		shaders[ 0 ].surfaceFlags = 0;
+		shaders[ 0 ].contentFlags = CONTENTS_SOLID;
+
+		std::vector<dplane_t> planes;
+		std::vector<dbrush_t> brushes;
+		std::vector<dbrushside_t> sides;
+
+		auto addPlane = [ &planes ]( int axis, float sign, float dist ) {
+			dplane_t plane = {};
+			plane.normal[ axis ] = sign;
+			plane.dist = dist;
+			planes.push_back( plane );
+			return int( planes.size() ) - 1;
+		};
+
+		// The collision code expects the sides of axial brushes in the order
+		// -x, +x, -y, +y, -z, +z.
+		auto addBrush = [ & ]( const int mins[ 3 ], const int maxs[ 3 ] ) {
+			dbrush_t brush;
+			brush.firstSide = sides.size();
+			brush.numSides = 6;
+			brush.shaderNum = 0;
+			brushes.push_back( brush );
+
+			for ( int axis = 0; axis < 3; axis++ )
+			{
+				dbrushside_t side;
+				side.shaderNum = 0;
+				side.planeNum = addPlane( axis, -1.0f, -mins[ axis ] );
+				sides.push_back( side );
+				side.planeNum = addPlane( axis, 1.0f, maxs[ axis ] );
+				sides.push_back( side );
+			}
+		};
+
+		int outerMins[ 3 ], outerMaxs[ 3 ];
+
+		for ( int axis = 0; axis < 3; axis++ )
+		{
+			outerMins[ axis ] = ARENA_MINS[ axis ] - WALL;
+			outerMaxs[ axis ] = ARENA_MAXS[ axis ] + WALL;
+		}
+
+		for ( int axis = 0; axis < 3; axis++ )
+		{
+			int mins[ 3 ], maxs[ 3 ];
+
+			VectorCopy( outerMins, mins );
+			VectorCopy( outerMaxs, maxs );
+			maxs[ axis ] = ARENA_MINS[ axis ];
+			addBrush( mins, maxs );
+
+			VectorCopy( outerMins, mins );
+			VectorCopy( outerMaxs, maxs );
+			mins[ axis ] = ARENA_MAXS[ axis ];
+			addBrush( mins, maxs );
+		}
+
+		int split = ( ARENA_MINS[ 2 ] + ARENA_MAXS[ 2 ] ) / 2;
+
+		dnode_t node;
+		node.planeNum = addPlane( 2, 1.0f, split );
+		node.children[ 0 ] = -1; // leaf 0, above the plane
+		node.children[ 1 ] = -2; // leaf 1, below it
+		VectorCopy( outerMins, node.mins );
+		VectorCopy( outerMaxs, node.maxs );
+
+		std::vector<int> leafBrushes;
+
+		for ( size_t i = 0; i < brushes.size(); i++ )
+		{
+			leafBrushes.push_back( i );
+		}
+
+		dleaf_t leafs[ 2 ];
+
+		for ( dleaf_t &leaf : leafs )
+		{
+			leaf.cluster = 0;
+			leaf.area = 0;
+			VectorCopy( outerMins, leaf.mins );
+			VectorCopy( outerMaxs, leaf.maxs );
+			leaf.firstLeafSurface = 0;
+			leaf.numLeafSurfaces = 0;
+			leaf.firstLeafBrush = 0;
+			leaf.numLeafBrushes = leafBrushes.size();
+		}
+
+		leafs[ 0 ].mins[ 2 ] = split;
+		leafs[ 1 ].maxs[ 2 ] = split;
+
+		dmodel_t world;
+		VectorCopy( outerMins, world.mins );
+		VectorCopy( outerMaxs, world.maxs );
+		world.firstSurface = 0;
+		world.numSurfaces = 0;
+		world.firstBrush = 0;
+		world.numBrushes = brushes.size();
+
+		dheader_t header = {};
+		header.ident = BSP_IDENT;
+		header.version = BSP_VERSION;
+
+		std::string bsp( sizeof( header ), '\0' );
+
+		AddLump( bsp, header, LUMP_ENTITIES, ENTITIES, sizeof( ENTITIES ) );
+		AddLump( bsp, header, LUMP_SHADERS, shaders.data(), shaders.size() );
+		AddLump( bsp, header, LUMP_PLANES, planes.data(), planes.size() );
+		AddLump( bsp, header, LUMP_NODES, &node, 1 );
+		AddLump( bsp, header, LUMP_LEAFS, leafs, 2 );
+		AddLump( bsp, header, LUMP_LEAFBRUSHES, leafBrushes.data(), leafBrushes.size() );
+		AddLump( bsp, header, LUMP_MODELS, &world, 1 );
+		AddLump( bsp, header, LUMP_BRUSHES, brushes.data(), brushes.size() );
+		AddLump( bsp, header, LUMP_BRUSHSIDES, sides.data(), sides.size() );
+
+		// The remaining lumps are left empty: no drawn surfaces, no light and
+		// no visibility data.
+		bsp.replace( 0, sizeof( header ), reinterpret_cast<const char*>( &header ), sizeof( header ) );
+
+		return bsp;
+	}
+
+	static void WriteFile( Str::StringRef path, Str::StringRef content )
+	{
+		FS::File file = FS::RawPath::OpenWrite( path );
+		file.Write( content.data(), content.size() );
+		file.Close();
+	}
+
+	std::string WriteArena( Str::StringRef pakDir )
+	{
+		WriteFile( FS::Path::Build( pakDir, Str::Format( "maps/%s.bsp", MAP_NAME ) ), BuildBSP() );
+		WriteFile( FS::Path::Build( pakDir, Str::Format( "layouts/%s/%s.dat", MAP_NAME, MAP_NAME ) ), LAYOUT );
+
+		return ENTITIES;
+	}
+
+}
@@ -0,0 +1,47 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// BenchmarkMap.h -- the arena the sgame benchmark runs in
+
+#ifndef BENCHMARK_MAP_H_
+#define BENCHMARK_MAP_H_
+
+#include "common/Common.h"
+
+namespace Benchmark {
+
+	// Name of the map, of its layout and of the package they are written to
+	constexpr const char *MAP_NAME = "benchmark";
+
+	/*
+	 * Writes <pakDir>/maps/benchmark.bsp, a closed 2048x2048x512 box with a
+	 * spawn point, and <pakDir>/layouts/benchmark/benchmark.dat, a small base
+	 * for each team on opposite sides of the box. Returns the entity string
+	 * of the map, which the engine hands out to the game.
+	 */
+	std::string WriteArena( Str::StringRef pakDir );
+
+}
+
+#endif // BENCHMARK_MAP_H_
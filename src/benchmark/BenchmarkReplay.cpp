@@ -0,0 +1,183 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "BenchmarkReplay.h"
+
+#include "engine/qcommon/q_shared.h"
+
+#include <sstream>
+
+namespace Benchmark {
+
+	// Everything after the first word, without the leading blanks
+	static std::string Rest( std::istringstream& stream )
+	{
+		std::string rest;
+		std::getline( stream >> std::ws, rest );
+		return rest;
+	}
+
+	static bool ParseLine( std::istringstream& stream, const std::string& keyword, Replay& replay, std::string& error )
+	{
+		Step step = {};
+
+		if ( keyword == "seed" )
+		{
+			if ( !( stream >> replay.seed ) )
+			{
+				error = "expected a number";
+				return false;
+			}
+
+			return true;
+		}
+
+		if ( keyword == "set" )
+		{
+			std::string name;
+
+			if ( !( stream >> name ) )
+			{
+				error = "expected a cvar name";
+				return false;
+			}
+
+			replay.cvars.emplace_back( name, Rest( stream ) );
+			return true;
+		}
+
+		if ( keyword == "server" )
+		{
+			step.kind = Step::Kind::SERVER_COMMAND;
+			step.text = Rest( stream );
+		}
+		else if ( keyword == "run" )
+		{
+			step.kind = Step::Kind::RUN;
+
+			if ( !( stream >> step.frames ) || step.frames <= 0 )
+			{
+				error = "expected a number of frames";
+				return false;
+			}
+		}
+		else
+		{
+			if ( keyword == "connect" )
+			{
+				step.kind = Step::Kind::CONNECT;
+			}
+			else if ( keyword == "disconnect" )
+			{
+				step.kind = Step::Kind::DISCONNECT;
+			}
+			else if ( keyword == "client" )
+			{
+				step.kind = Step::Kind::CLIENT_COMMAND;
+			}
+			else if ( keyword == "move" )
+			{
+				step.kind = Step::Kind::MOVE;
+			}
+			else
+			{
+				error = "unknown keyword " + keyword;
+				return false;
+			}
+
+			if ( !( stream >> step.client ) || step.client < 0 || step.client >= MAX_CLIENTS )
+			{
+				error = "expected a client number";
+				return false;
+			}
+
+			if ( step.kind == Step::Kind::MOVE )
+			{
+				int forward, right, up;
+
+				if ( !( stream >> forward >> right >> up >> step.pitch >> step.yaw ) )
+				{
+					error = "expected <forward> <right> <up> <pitch> <yaw>";
+					return false;
+				}
+
+				step.forward = Math::Clamp( forward, -127, 127 );
+				step.right = Math::Clamp( right, -127, 127 );
+				step.up = Math::Clamp( up, -127, 127 );
+
+				int button;
+
+				while ( stream >> button )
+				{
+					if ( button < 0 || button >= USERCMD_BUTTONS )
+					{
+						error = "bad button number";
+						return false;
+					}
+
+					step.buttons.push_back( button );
+				}
+
+				if ( !stream.eof() )
+				{
+					error = "expected a button number";
+					return false;
+				}
+			}
+			else
+			{
+				step.text = Rest( stream );
+			}
+		}
+
+		replay.steps.push_back( std::move( step ) );
+		return true;
+	}
+
+	bool ParseReplay( Str::StringRef text, Replay& replay, std::string& error )
+	{
+		std::istringstream lines( text );
+		std::string line;
+
+		for ( int lineNum = 1; std::getline( lines, line ); lineNum++ )
+		{
+			std::istringstream stream( line );
+			std::string keyword;
+
+			if ( !( stream >> keyword ) || keyword[ 0 ] == '#' )
+			{
+				continue;
+			}
+
+			if ( !ParseLine( stream, keyword, replay, error ) )
+			{
+				error = Str::Format( "line %d: %s", lineNum, error );
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,83 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// BenchmarkReplay.h -- the usercmd stream replayed by the sgame benchmark
+
+#ifndef BENCHMARK_REPLAY_H_
+#define BENCHMARK_REPLAY_H_
+
+#include "common/Common.h"
+
+namespace Benchmark {
+
+	/*
+	 * A replay is a list of steps, one per line of the replay file:
+	 *
+	 *   seed <n>                     random seed given to the game
+	 *   set <cvar> <value>           set a cvar before the game starts
+	 *   connect <client> <name>      connect and spawn a client
+	 *   disconnect <client>
+	 *   server <command>             run a server console command
+	 *   client <client> <command>    a command sent by a client
+	 *   move <client> <forward> <right> <up> <pitch> <yaw> [<button>...]
+	 *                                the usercmd the client sends from now on
+	 *   run <frames>                 run the server for that many frames
+	 *
+	 * Usercmds are run-length encoded: a client keeps sending its last move
+	 * until the next one. Buttons are the numbers of buttonNumber_t.
+	 */
+	struct Step
+	{
+		enum class Kind
+		{
+			CONNECT,
+			DISCONNECT,
+			SERVER_COMMAND,
+			CLIENT_COMMAND,
+			MOVE,
+			RUN,
+		};
+
+		Kind kind;
+		int client;
+		int frames;
+		std::string text;
+		signed char forward, right, up;
+		float pitch, yaw;
+		std::vector<int> buttons;
+	};
+
+	struct Replay
+	{
+		int seed = 0;
+		std::vector<std::pair<std::string, std::string>> cvars;
+		std::vector<Step> steps;
+	};
+
+	// Parses a replay file, returns false and sets the error if it is malformed.
+	bool ParseReplay( Str::StringRef text, Replay& replay, std::string& error );
+
+}
+
+#endif // BENCHMARK_REPLAY_H_
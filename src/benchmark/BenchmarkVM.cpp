@@ -0,0 +1,271 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "BenchmarkVM.h"
+#include "BenchmarkMap.h"
+
+#include "engine/server/sg_msgdef.h"
+
+namespace Benchmark {
+
+	GameVM::GameVM()
+		: VM::VMBase( "sgame", Cvar::NONE ), entityParsePoint( nullptr ), usercmds(), connected(), bots()
+	{
+	}
+
+	void GameVM::Start( std::string entities )
+	{
+		entityString = std::move( entities );
+		entityParsePoint = entityString.c_str();
+
+		services = std::unique_ptr<VM::CommonVMServices>( new VM::CommonVMServices( *this, "SGame", FS::Owner::SGAME, Cmd::SGAME_VM ) );
+
+		this->Create();
+		this->SendMsg<GameStaticInitMsg>( Sys::Milliseconds() );
+	}
+
+	void GameVM::Shutdown()
+	{
+		if ( !this->IsActive() )
+		{
+			return;
+		}
+
+		this->SendMsg<GameShutdownMsg>( false );
+		this->Free();
+		services = nullptr;
+	}
+
+	void GameVM::GameInit( int levelTime, int randomSeed )
+	{
+		this->SendMsg<GameInitMsg>( levelTime, randomSeed, true, false );
+	}
+
+	bool GameVM::ClientConnect( int clientNum, Str::StringRef name, std::string& reason )
+	{
+		bool denied;
+
+		userinfos[ clientNum ] = Str::Format( "\\name\\%s\\ip\\localhost", name );
+		usercmds[ clientNum ] = {};
+		connected[ clientNum ] = true;
+		this->SendMsg<GameClientConnectMsg>( clientNum, true, 0, denied, reason );
+
+		if ( denied )
+		{
+			connected[ clientNum ] = false;
+		}
+
+		return !denied;
+	}
+
+	void GameVM::ClientBegin( int clientNum )
+	{
+		this->SendMsg<GameClientBeginMsg>( clientNum );
+	}
+
+	void GameVM::ClientCommand( int clientNum, const std::string& command )
+	{
+		this->SendMsg<GameClientCommandMsg>( clientNum, command );
+	}
+
+	void GameVM::ClientDisconnect( int clientNum )
+	{
+		if ( !connected[ clientNum ] )
+		{
+			return;
+		}
+
+		this->SendMsg<GameClientDisconnectMsg>( clientNum );
+		connected[ clientNum ] = false;
+		bots[ clientNum ] = false;
+	}
+
+	void GameVM::ClientThink( int clientNum )
+	{
+		this->SendMsg<GameClientThinkMsg>( clientNum );
+	}
+
+	void GameVM::RunFrame( int levelTime )
+	{
+		this->SendMsg<GameRunFrameMsg>( levelTime );
+
+		for ( int clientNum : droppedClients )
+		{
+			ClientDisconnect( clientNum );
+		}
+
+		droppedClients.clear();
+	}
+
+	void GameVM::Syscall( uint32_t id, Util::Reader reader, IPC::Channel& channel )
+	{
+		int major = id >> 16;
+		int minor = id & 0xffff;
+
+		if ( major == VM::QVM )
+		{
+			this->QVMSyscall( minor, reader, channel );
+		}
+		else if ( major < VM::LAST_COMMON_SYSCALL )
+		{
+			services->Syscall( major, minor, std::move( reader ), channel );
+		}
+		else
+		{
+			Sys::Drop( "Bad major game syscall number: %d", major );
+		}
+	}
+
+	void GameVM::QVMSyscall( int syscallNum, Util::Reader& reader, IPC::Channel& channel )
+	{
+		switch ( syscallNum )
+		{
+		case G_LOCATE_GAME_DATA1:
+			IPC::HandleMsg<LocateGameDataMsg1>( channel, std::move( reader ), [ this ]( IPC::SharedMemory shm, int, int, int ) {
+				// Keep the entities mapped, nothing reads them here
+				shmRegion = std::move( shm );
+			} );
+			break;
+
+		case G_LOCATE_GAME_DATA2:
+			IPC::HandleMsg<LocateGameDataMsg2>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		case G_ADJUST_AREA_PORTAL_STATE:
+			IPC::HandleMsg<AdjustAreaPortalStateMsg>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		case G_DROP_CLIENT:
+			IPC::HandleMsg<DropClientMsg>( channel, std::move( reader ), [ this ]( int clientNum, std::string reason ) {
+				Log::Notice( "client %d dropped: %s", clientNum, reason );
+				droppedClients.push_back( clientNum );
+			} );
+			break;
+
+		case G_SEND_SERVER_COMMAND:
+			IPC::HandleMsg<SendServerCommandMsg>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		case G_SET_CONFIGSTRING:
+			IPC::HandleMsg<SetConfigStringMsg>( channel, std::move( reader ), [ this ]( int index, std::string value ) {
+				configStrings[ index ] = std::move( value );
+			} );
+			break;
+
+		case G_GET_CONFIGSTRING:
+			IPC::HandleMsg<GetConfigStringMsg>( channel, std::move( reader ), [ this ]( int index, int len, std::string& result ) {
+				result = configStrings[ index ].substr( 0, std::max( len - 1, 0 ) );
+			} );
+			break;
+
+		case G_SET_CONFIGSTRING_RESTRICTIONS:
+			IPC::HandleMsg<SetConfigStringRestrictionsMsg>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		case G_SET_USERINFO:
+			IPC::HandleMsg<SetUserinfoMsg>( channel, std::move( reader ), [ this ]( int clientNum, std::string userinfo ) {
+				userinfos[ clientNum ] = std::move( userinfo );
+			} );
+			break;
+
+		case G_GET_USERINFO:
+			IPC::HandleMsg<GetUserinfoMsg>( channel, std::move( reader ), [ this ]( int clientNum, int len, std::string& result ) {
+				result = userinfos[ clientNum ].substr( 0, std::max( len - 1, 0 ) );
+			} );
+			break;
+
+		case G_GET_SERVERINFO:
+			IPC::HandleMsg<GetServerinfoMsg>( channel, std::move( reader ), []( int len, std::string& result ) {
+				result = Str::Format( "\\mapname\\%s\\sv_hostname\\sgame benchmark", MAP_NAME ).substr( 0, std::max( len - 1, 0 ) );
+			} );
+			break;
+
+		case G_GET_USERCMD:
+			IPC::HandleMsg<GetUsercmdMsg>( channel, std::move( reader ), [ this ]( int clientNum, usercmd_t& cmd ) {
+				cmd = usercmds[ clientNum ];
+			} );
+			break;
+
+		case G_GET_ENTITY_TOKEN:
+			IPC::HandleMsg<GetEntityTokenMsg>( channel, std::move( reader ), [ this ]( bool& more, std::string& token ) {
+				token = COM_Parse( &entityParsePoint );
+				more = entityParsePoint || !token.empty();
+			} );
+			break;
+
+		case G_GET_PLAYER_PUBKEY:
+			IPC::HandleMsg<GetPlayerPubkeyMsg>( channel, std::move( reader ), []( int clientNum, int, std::string& pubkey ) {
+				// Only the length is checked, make it unique for the guids.
+				pubkey = std::string( RSA_STRING_LENGTH - 1 - 8, '0' ) + Str::Format( "%08x", clientNum );
+			} );
+			break;
+
+		case G_GEN_FINGERPRINT:
+			IPC::HandleMsg<GenFingerprintMsg>( channel, std::move( reader ), []( int, const std::vector<char>& key, int len, std::string& fingerprint ) {
+				std::string pubkey( key.data(), strnlen( key.data(), key.size() ) );
+				fingerprint = pubkey.substr( pubkey.size() - std::min<size_t>( pubkey.size(), 32 ) ).substr( 0, std::max( len - 1, 0 ) );
+			} );
+			break;
+
+		case G_RSA_GENMSG:
+			IPC::HandleMsg<RSAGenMsgMsg>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		case G_GET_TIME_STRING:
+			IPC::HandleMsg<GetTimeStringMsg>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		case BOT_ALLOCATE_CLIENT:
+			IPC::HandleMsg<BotAllocateClientMsg>( channel, std::move( reader ), [ this ]( int& clientNum ) {
+				clientNum = -1;
+
+				// Take the slots from the end, the replay uses the first ones.
+				for ( int i = MAX_CLIENTS - 1; i >= 0; i-- )
+				{
+					if ( !connected[ i ] )
+					{
+						connected[ i ] = bots[ i ] = true;
+						clientNum = i;
+						break;
+					}
+				}
+			} );
+			break;
+
+		case BOT_FREE_CLIENT:
+			IPC::HandleMsg<BotFreeClientMsg>( channel, std::move( reader ), [ this ]( int clientNum ) {
+				connected[ clientNum ] = bots[ clientNum ] = false;
+			} );
+			break;
+
+		case BOT_GET_CONSOLE_MESSAGE:
+			IPC::HandleMsg<BotGetConsoleMessageMsg>( channel, std::move( reader ), []( auto&&... ) {} );
+			break;
+
+		default:
+			Sys::Drop( "the benchmark does not implement game syscall %d", syscallNum );
+		}
+	}
+
+}
@@ -0,0 +1,86 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// BenchmarkVM.h -- the sgame loaded by the benchmark, and the stub of the
+// engine services it calls
+
+#ifndef BENCHMARK_VM_H_
+#define BENCHMARK_VM_H_
+
+#include "common/Common.h"
+#include "engine/qcommon/q_shared.h"
+#include "engine/framework/VirtualMachine.h"
+#include "engine/framework/CommonVMServices.h"
+
+namespace Benchmark {
+
+	/*
+	 * Stands in for the server: the game syscalls (the trap_* functions of
+	 * the sgame which are not implemented in the sgame itself) are answered
+	 * from a table of configstrings and userinfos and from the usercmds set
+	 * by the replay. Everything going to the network is dropped. The common
+	 * syscalls (cvars, commands, logs, files) use the real engine services.
+	 */
+	class GameVM : public VM::VMBase
+	{
+	public:
+		GameVM();
+
+		void Start( std::string entityString );
+		void Shutdown();
+
+		void GameInit( int levelTime, int randomSeed );
+		bool ClientConnect( int clientNum, Str::StringRef name, std::string& reason );
+		void ClientBegin( int clientNum );
+		void ClientCommand( int clientNum, const std::string& command );
+		void ClientDisconnect( int clientNum );
+		void ClientThink( int clientNum );
+
+		// Also disconnects the clients the game dropped during the frame
+		void RunFrame( int levelTime );
+
+		usercmd_t& Usercmd( int clientNum ) { return usercmds[ clientNum ]; }
+		bool Connected( int clientNum ) const { return connected[ clientNum ]; }
+
+	private:
+		void Syscall( uint32_t id, Util::Reader reader, IPC::Channel& channel ) override;
+		void QVMSyscall( int syscallNum, Util::Reader& reader, IPC::Channel& channel );
+
+		std::unique_ptr<VM::CommonVMServices> services;
+		IPC::SharedMemory shmRegion;
+
+		std::string entityString;
+		const char *entityParsePoint;
+
+		std::map<int, std::string> configStrings;
+		std::string userinfos[ MAX_CLIENTS ];
+		usercmd_t usercmds[ MAX_CLIENTS ];
+		bool connected[ MAX_CLIENTS ];
+		bool bots[ MAX_CLIENTS ];
+		std::vector<int> droppedClients;
+	};
+
+}
+
+#endif // BENCHMARK_VM_H_
@@ -36,6 +36,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "engine/renderer/tr_types.h"
 #include "shared/client/cg_api.h"
 #include "shared/bg_public.h"
+#include "shared/TraceProfile.h"
 #include "engine/client/keycodes.h"
 #include "cg_ui.h"
 #include "cg_skeleton_modifier.h"
@@ -2074,6 +2075,11 @@ void CG_CapTrace( trace_t *result, const vec3_t start, const vec3_t mins, const
                   const vec3_t end, int skipNumber, int mask, int skipmask );
 void CG_PredictPlayerState();
 
+// attribute the traces to their call site, see TraceProfile.h
+// (the definitions use parenthesized names to escape these)
+#define CG_Trace( ... ) TRACE_PROFILE_CALL( CG_Trace( __VA_ARGS__ ) )
+#define CG_CapTrace( ... ) TRACE_PROFILE_CALL( CG_CapTrace( __VA_ARGS__ ) )
+
 //
 // cg_events.c
 //
@@ -90,6 +90,8 @@ void CG_BuildSolidList()
 	}
 }
 
+static Cvar::Cvar<bool> cg_analyticBoxClip( "cg_analyticBoxClip", "clip traces against entity boxes without the generic BSP code", Cvar::NONE, true );
+
 /*
 ====================
 CG_ClipMoveToEntities
@@ -103,6 +105,7 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 	int           x, zd, zu;
 	trace_t       trace;
 	clipHandle_t  cmodel;
+	bool          traced;
 	vec3_t        tmins, tmaxs;
 	vec3_t        bmins, bmaxs;
 	vec3_t        origin, angles;
@@ -135,6 +138,8 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 			continue;
 		}
 
+		traced = false;
+
 		if ( ent->solid == SOLID_BMODEL )
 		{
 			// special value for bmodel
@@ -172,20 +177,33 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 			if( !BoundsIntersect( bmins, bmaxs, tmins, tmaxs ) )
 				continue;
 
-			cmodel = CM_TempBoxModel( bmins, bmaxs, /* capsule = */ false );
+			if ( collisionType == traceType_t::TT_AABB && cg_analyticBoxClip.Get() )
+			{
+				// plain box against box, no need for the collision model
+				BG_BoxTraceAgainstBox( &trace, start, end, mins, maxs, bmins, bmaxs, vec3_origin, mask, skipmask );
+				traced = true;
+			}
+			else
+			{
+				cmodel = CM_TempBoxModel( bmins, bmaxs, /* capsule = */ false );
+			}
+
 			VectorCopy( vec3_origin, angles );
 			VectorCopy( vec3_origin, origin );
 		}
 
-		switch ( collisionType )
+		if ( !traced )
 		{
-		case traceType_t::TT_CAPSULE:
-		case traceType_t::TT_AABB:
-			CM_TransformedBoxTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask, origin, angles, collisionType );
-			break;
+			switch ( collisionType )
+			{
+			case traceType_t::TT_CAPSULE:
+			case traceType_t::TT_AABB:
+				CM_TransformedBoxTrace( &trace, start, end, mins, maxs, cmodel, mask, skipmask, origin, angles, collisionType );
+				break;
 
-		default: // Shouldn't Happen
-			ASSERT_UNREACHABLE();
+			default: // Shouldn't Happen
+				ASSERT_UNREACHABLE();
+			}
 		}
 
 		if ( trace.allsolid || trace.fraction < tr->fraction )
@@ -213,9 +231,10 @@ static void CG_ClipMoveToEntities( const vec3_t start, const vec3_t mins,
 CG_Trace
 ================
 */
-void CG_Trace( trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs,
+void ( CG_Trace )( trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs,
                const vec3_t end, int skipNumber, int mask, int skipmask )
 {
+	TraceProfile::Timer timer( TraceProfile::Kind::TRACE );
 	trace_t t;
 
 	CM_BoxTrace( &t, start, end, mins, maxs, 0, mask, skipmask, traceType_t::TT_AABB );
@@ -235,9 +254,10 @@ void CG_Trace( trace_t *result, const vec3_t start, const vec3_t mins, const vec
 CG_CapTrace
 ================
 */
-void  CG_CapTrace( trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs,
+void  ( CG_CapTrace )( trace_t *result, const vec3_t start, const vec3_t mins, const vec3_t maxs,
                    const vec3_t end, int skipNumber, int mask, int skipmask )
 {
+	TraceProfile::Timer timer( TraceProfile::Kind::TRACE );
 	trace_t t;
 
 	CM_BoxTrace( &t, start, end, mins, maxs, 0, mask, skipmask, traceType_t::TT_CAPSULE );
@@ -864,11 +884,13 @@ void CG_PredictPlayerState()
 
 		if ( !cg_optimizePrediction.Get() )
 		{
+			TRACE_PROFILE_SCOPE();
 			Pmove( &cg_pmove );
 		}
 		else if ( cg_optimizePrediction.Get() && ( cmdNum >= predictCmd ||
 		          ( stateIndex + 1 ) % NUM_SAVED_STATES == cg.stateHead ) )
 		{
+			TRACE_PROFILE_SCOPE();
 			Pmove( &cg_pmove );
 			// record the last predicted command
 			cg.lastPredictedCommand = cmdNum;
@@ -265,6 +265,32 @@ public:
 };
 static TestShaderCmd testShaderCmdRegistration;
 
+static Cvar::Cvar<bool> cg_traceProfile("cg_traceProfile", "record per call site statistics of traces, see trace_stats_cgame", Cvar::NONE, false);
+static Cvar::Cvar<int> cg_traceProfileLogInterval("cg_traceProfileLogInterval", "log the trace statistics every x seconds (0 = never)", Cvar::NONE, 0);
+
+class TraceStatsCmd : public Cmd::StaticCmd
+{
+public:
+	TraceStatsCmd() : StaticCmd("trace_stats_cgame", "print per call site statistics of cgame traces (see cg_traceProfile)") {}
+
+	void Run( const Cmd::Args &args ) const override
+	{
+		if ( args.Argc() > 1 && args.Argv( 1 ) == "reset" )
+		{
+			TraceProfile::Reset();
+			return;
+		}
+
+		if ( !TraceProfile::enabled )
+		{
+			Print( "trace profiling is disabled, see cg_traceProfile" );
+		}
+
+		Print( TraceProfile::Report( 50 ) );
+	}
+};
+static TraceStatsCmd traceStatsCmdRegistration;
+
 //============================================================================
 
 /*
@@ -1866,6 +1892,8 @@ void CG_DrawActiveFrame( int serverTime, bool demoPlayback )
 	cg.demoPlayback = demoPlayback;
 	cg.currentCmdNumber = trap_GetCurrentCmdNumber();
 
+	TraceProfile::Frame( cg.time, cg_traceProfile.Get(), cg_traceProfileLogInterval.Get() );
+
 	CG_ResetMarks();
 
 	CG_NotifyHooks();
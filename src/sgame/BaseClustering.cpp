@@ -23,6 +23,7 @@ along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
 
 #include "common/Common.h"
 #include "sg_local.h"
+#include "sg_cm_world.h"
 
 #define MININUM_BASE_RADIUS 128.0f
 
@@ -47,7 +48,7 @@ namespace Clustering {
 			 * @brief An edge visibility check that checks for PVS visibility.
 			 */
 			static bool edgeVisPVS(gentity_t *a, gentity_t *b) {
-				return trap_InPVSIgnorePortals(a->s.origin, b->s.origin);
+				return G_EntitiesInPVSIgnorePortals(a, b);
 			}
 	};
 }
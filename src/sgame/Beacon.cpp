@@ -27,6 +27,7 @@ along with Daemon.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "common/Common.h"
 #include "sg_local.h"
+#include "sg_cm_world.h"
 #include "Entities.h"
 
 // entityState_t   | cbeacon_t    | description
@@ -169,7 +170,7 @@ namespace Beacon //this should eventually become a class
 
 		ent = G_NewEntity( NO_CBSE );
 		ent->s.eType = entityType_t::ET_BEACON;
-		ent->classname = BG_strdup( "beacon" );
+		G_SetClassname( ent, "beacon" );
 
 		ent->s.bc_type = type;
 		ent->s.bc_data = data;
@@ -612,6 +613,17 @@ namespace Beacon //this should eventually become a class
 		}
 	}
 
+	// cosine of the half angle of the cone TagTrace looks into
+	static const float TAG_CONE_COS = 0.9f;
+
+	/**
+	 * @brief Radius of the cone TagTrace looks into, at the given distance from its apex.
+	 */
+	float TagTraceRadius( float distance )
+	{
+		return distance * sqrtf( 1.0f - Square( TAG_CONE_COS ) ) / TAG_CONE_COS;
+	}
+
 	/**
 	 * @brief Perform an approximate trace to find a taggable entity.
 	 * @param team           Team the caller belongs to.
@@ -634,7 +646,7 @@ namespace Beacon //this should eventually become a class
 			}
 		}
 
-		float bestDot = 0.9;
+		float bestDot = TAG_CONE_COS;
 		gentity_t *bestEnt = nullptr;
 
 		for( int i = 0; i < level.num_entities; i++ )
@@ -650,19 +662,21 @@ namespace Beacon //this should eventually become a class
 			if( !EntityTaggable( i, team, true ) )
 				continue;
 
-			glm::vec3 delta = VEC2GLM( ent->r.currentOrigin ) - begin;
+			// where the traces see it, rewound while unlagged is on
+			const float *origin = G_CM_TraceOrigin( ent );
+			glm::vec3 delta = VEC2GLM( origin ) - begin;
 			float dot = glm::dot( dir, delta ) / glm::length( delta );
 
 			if( dot <= bestDot )
 				continue;
 
-			if( !trap_InPVS( ent->r.currentOrigin, GLM4READ( begin ) ) )
+			if( !trap_InPVS( origin, GLM4READ( begin ) ) )
 				continue;
 
 			// LOS
 			{
 				trace_t tr;
-				trap_Trace( &tr, begin, {}, {}, VEC2GLM( ent->r.currentOrigin ), skip, mask, 0 );
+				trap_Trace( &tr, begin, {}, {}, VEC2GLM( origin ), skip, mask, 0 );
 				if( tr.entityNum != i )
 					continue;
 			}
@@ -0,0 +1,107 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "FrameProfile.h"
+
+#include <atomic>
+
+namespace FrameProfile {
+
+	static_assert( ( RING_SIZE & ( RING_SIZE - 1 ) ) == 0, "RING_SIZE must be a power of two" );
+
+	bool enabled = false;
+
+	// Spans are only written by the game thread. The head is published after
+	// the span is written so a reader never has to take a lock: it reads the
+	// head first and only looks at the spans before it.
+	static Event ring[ RING_SIZE ];
+	static std::atomic<uint32_t> head{ 0 };
+
+	static int64_t Microseconds( std::chrono::steady_clock::time_point time )
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>( time.time_since_epoch() ).count();
+	}
+
+	void Scope::Record( const char *name, int entityNum,
+	                    std::chrono::steady_clock::time_point start,
+	                    std::chrono::steady_clock::time_point end )
+	{
+		uint32_t slot = head.load( std::memory_order_relaxed );
+		Event &event = ring[ slot & ( RING_SIZE - 1 ) ];
+
+		event.name = name;
+		event.entityNum = entityNum;
+		event.start = Microseconds( start );
+		event.duration = Microseconds( end ) - event.start;
+
+		head.store( slot + 1, std::memory_order_release );
+	}
+
+	void Frame( bool enable )
+	{
+		if ( enable && !enabled )
+		{
+			head.store( 0, std::memory_order_release );
+		}
+
+		enabled = enable;
+	}
+
+	int NumEvents()
+	{
+		return static_cast<int>( std::min<uint32_t>( head.load( std::memory_order_acquire ), RING_SIZE ) );
+	}
+
+	std::string ChromeTrace()
+	{
+		uint32_t end = head.load( std::memory_order_acquire );
+		uint32_t begin = end > RING_SIZE ? end - RING_SIZE : 0;
+
+		std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		for ( uint32_t slot = begin; slot != end; slot++ )
+		{
+			const Event &event = ring[ slot & ( RING_SIZE - 1 ) ];
+
+			if ( slot != begin )
+			{
+				json += ",\n";
+			}
+
+			json += Str::Format( "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%d,\"dur\":%d",
+			                     event.name, event.start, event.duration );
+
+			if ( event.entityNum >= 0 )
+			{
+				json += Str::Format( ",\"args\":{\"entity\":%d}", event.entityNum );
+			}
+
+			json += "}";
+		}
+
+		json += "]}\n";
+
+		return json;
+	}
+}
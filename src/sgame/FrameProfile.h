@@ -0,0 +1,104 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// FrameProfile.h -- timeline of the phases of the server frame
+
+#ifndef SGAME_FRAME_PROFILE_H_
+#define SGAME_FRAME_PROFILE_H_
+
+#include "common/Common.h"
+
+#include <chrono>
+
+namespace FrameProfile {
+
+	/**
+	 * @brief A timed span of the frame. Spans are kept in a ring buffer holding
+	 *        the most recent RING_SIZE of them, oldest get overwritten.
+	 */
+	struct Event
+	{
+		const char *name; // must be a string literal, it is stored as is
+		int        entityNum; // the entity the span is about, or -1
+		int64_t    start; // microseconds
+		int64_t    duration;
+	};
+
+	constexpr int RING_SIZE = 1 << 16;
+
+	extern bool enabled;
+
+	/**
+	 * @brief Records the span of its lifetime under the given name.
+	 */
+	class Scope
+	{
+	public:
+		explicit Scope( const char *name, int entityNum = -1 )
+			: name_( name ), entityNum_( entityNum ), running_( enabled )
+		{
+			if ( running_ )
+			{
+				start_ = std::chrono::steady_clock::now();
+			}
+		}
+
+		~Scope()
+		{
+			if ( running_ )
+			{
+				Record( name_, entityNum_, start_, std::chrono::steady_clock::now() );
+			}
+		}
+
+	private:
+		static void Record( const char *name, int entityNum,
+		                    std::chrono::steady_clock::time_point start,
+		                    std::chrono::steady_clock::time_point end );
+
+		const char *name_;
+		int        entityNum_;
+		bool       running_;
+		std::chrono::steady_clock::time_point start_;
+	};
+
+	/**
+	 * @brief To be called at the start of each frame, turns profiling on or off.
+	 *        Turning it on discards the previously recorded spans.
+	 */
+	void Frame( bool enable );
+
+	// number of spans currently held by the ring buffer
+	int NumEvents();
+
+	// the recorded spans in the Chrome trace event format, to be loaded in
+	// chrome://tracing or https://ui.perfetto.dev
+	std::string ChromeTrace();
+}
+
+// times the enclosing block
+#define FRAME_PROFILE_SCOPE( name ) \
+	FrameProfile::Scope frameProfileScope( name )
+
+#endif // SGAME_FRAME_PROFILE_H_
@@ -0,0 +1,637 @@
+/*
+===========================================================================
+
+Daemon BSD Source Code
+Copyright (c) 2026 Daemon Developers
+All rights reserved.
+
+This file is part of the Daemon BSD Source Code (Daemon Source Code).
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Daemon developers nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL DAEMON DEVELOPERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+===========================================================================
+*/
+
+#include "common/Common.h"
+#include "bot_local.h"
+#include "sgame/sg_local.h"
+
+#include "DetourNode.h"
+
+#include <queue>
+#include <unordered_set>
+
+/*
+====================
+bot_cluster.cpp
+
+Hierarchical pathfinding on top of the navmesh
+
+Each tile of a navmesh is a node of a coarse graph, linked to the tiles its
+polygons have links to. For every pair of linked tiles one portal is kept, the
+pair of polygons closest to the middle of the two tiles. Long routes are first
+searched in this graph, then refined by searching the navmesh between every
+few portals, so that no single search has to expand the whole route.
+
+The coarse graph knows nothing about the query filters nor about regions of
+a tile which are not connected, a refinement which fails falls back to a
+search of the whole route.
+
+The tiles rebuilt by the tile cache get a new reference: the tiles touched by
+obstacles are marked, and their nodes and those of their neighbours are built
+again once the tile cache has rebuilt them.
+====================
+*/
+
+static Cvar::Cvar<int> g_bot_clusterDistance( "g_bot_clusterDistance",
+	"routes between tiles at least this far apart are planned on the graph of tiles first, 0 to disable",
+	Cvar::NONE, 4 );
+static Cvar::Range<Cvar::Cvar<int>> g_bot_clusterSegment( "g_bot_clusterSegment",
+	"number of tiles of the coarse route covered by each refining search", Cvar::NONE, 3, 1, 64 );
+
+struct ClusterPortal_t
+{
+	int       to;       // tile index
+	dtPolyRef fromPoly; // in this tile
+	dtPolyRef toPoly;   // in the other tile
+	float     pos[ 3 ]; // middle of the centers of the polygons
+	float     toPos[ 3 ];
+};
+
+struct ClusterNode_t
+{
+	dtTileRef ref; // 0 if there is no tile at this index
+	int       x;
+	int       y;
+	float     center[ 3 ];
+	std::vector<ClusterPortal_t> portals;
+
+	// search state, valid when generation is the one of the search
+	int       generation;
+	float     cost;
+	float     pos[ 3 ];
+	int       parent;
+	int       parentPortal;
+	bool      closed;
+};
+
+struct ClusterGraph_t
+{
+	std::vector<ClusterNode_t> nodes; // by tile index
+	std::unordered_set<int>    dirtyColumns; // packed tile coordinates
+	int                        generation;
+};
+
+static ClusterGraph_t clusterGraph[ MAX_NAV_DATA ];
+
+static int PackColumn( int x, int y )
+{
+	return ( x & 0xffff ) << 16 | ( y & 0xffff );
+}
+
+static void PolyCenter( const dtMeshTile *tile, const dtPoly *poly, float *center )
+{
+	dtVset( center, 0, 0, 0 );
+
+	for ( int i = 0; i < poly->vertCount; i++ )
+	{
+		dtVadd( center, center, &tile->verts[ poly->verts[ i ] * 3 ] );
+	}
+
+	dtVscale( center, center, 1.0f / std::max<int>( poly->vertCount, 1 ) );
+}
+
+static void BuildNode( const dtNavMesh *mesh, ClusterGraph_t &graph, int index )
+{
+	ClusterNode_t &node = graph.nodes[ index ];
+	const dtMeshTile *tile = mesh->getTile( index );
+
+	node.portals.clear();
+
+	if ( !tile->header )
+	{
+		node.ref = 0;
+		return;
+	}
+
+	node.ref = mesh->getTileRef( tile );
+	node.x = tile->header->x;
+	node.y = tile->header->y;
+	dtVlerp( node.center, tile->header->bmin, tile->header->bmax, 0.5f );
+
+	// the best candidate for each neighbouring tile
+	std::vector<float> bestDistance;
+
+	for ( int i = 0; i < tile->header->polyCount; i++ )
+	{
+		const dtPoly *poly = &tile->polys[ i ];
+		float fromPos[ 3 ];
+		bool centered = false;
+
+		for ( unsigned int k = poly->firstLink; k != DT_NULL_LINK; k = tile->links[ k ].next )
+		{
+			dtPolyRef neighbourRef = tile->links[ k ].ref;
+			int to = mesh->decodePolyIdTile( neighbourRef );
+
+			if ( to == index )
+			{
+				continue;
+			}
+
+			const dtMeshTile *neighbourTile;
+			const dtPoly *neighbourPoly;
+			mesh->getTileAndPolyByRefUnsafe( neighbourRef, &neighbourTile, &neighbourPoly );
+
+			if ( !centered )
+			{
+				PolyCenter( tile, poly, fromPos );
+				centered = true;
+			}
+
+			ClusterPortal_t portal;
+			portal.to = to;
+			portal.fromPoly = mesh->getPolyRefBase( tile ) | ( dtPolyRef ) i;
+			portal.toPoly = neighbourRef;
+			PolyCenter( neighbourTile, neighbourPoly, portal.toPos );
+			dtVlerp( portal.pos, fromPos, portal.toPos, 0.5f );
+
+			float middle[ 3 ], neighbourCenter[ 3 ];
+			dtVlerp( neighbourCenter, neighbourTile->header->bmin, neighbourTile->header->bmax, 0.5f );
+			dtVlerp( middle, node.center, neighbourCenter, 0.5f );
+			float distance = dtVdistSqr( portal.pos, middle );
+
+			size_t j = 0;
+
+			while ( j < node.portals.size() && node.portals[ j ].to != to )
+			{
+				j++;
+			}
+
+			if ( j == node.portals.size() )
+			{
+				node.portals.push_back( portal );
+				bestDistance.push_back( distance );
+			}
+			else if ( distance < bestDistance[ j ] )
+			{
+				node.portals[ j ] = portal;
+				bestDistance[ j ] = distance;
+			}
+		}
+	}
+}
+
+/*
+====================
+BotBuildClusters
+
+Builds the coarse graph of a navmesh whose tiles have all been built
+====================
+*/
+void BotBuildClusters( NavData_t &nav )
+{
+	ClusterGraph_t &graph = clusterGraph[ &nav - BotNavData ];
+	const dtNavMesh *mesh = nav.mesh;
+
+	graph.nodes.assign( mesh->getMaxTiles(), ClusterNode_t{} );
+	graph.dirtyColumns.clear();
+	graph.generation = 0;
+
+	for ( int i = 0; i < mesh->getMaxTiles(); i++ )
+	{
+		BuildNode( mesh, graph, i );
+	}
+}
+
+void BotClearClusters()
+{
+	for ( ClusterGraph_t &graph : clusterGraph )
+	{
+		graph.nodes.clear();
+		graph.dirtyColumns.clear();
+	}
+}
+
+/*
+====================
+BotMarkClustersDirty
+
+Remembers the tiles touched by an obstacle, given in recast coordinates, until
+the tile cache rebuilds them, or all the tiles of the navmesh if there is no box
+====================
+*/
+void BotMarkClustersDirty( NavData_t *nav, const rVec *bmin, const rVec *bmax )
+{
+	ClusterGraph_t &graph = clusterGraph[ nav - BotNavData ];
+
+	if ( !bmin || !bmax )
+	{
+		for ( int i = 0; i < nav->mesh->getMaxTiles(); i++ )
+		{
+			const dtMeshTile *tile = nav->mesh->getTile( i );
+
+			if ( tile->header )
+			{
+				graph.dirtyColumns.insert( PackColumn( tile->header->x, tile->header->y ) );
+			}
+		}
+
+		return;
+	}
+
+	int minX, minY, maxX, maxY;
+
+	nav->mesh->calcTileLoc( *bmin, &minX, &minY );
+	nav->mesh->calcTileLoc( *bmax, &maxX, &maxY );
+
+	for ( int x = minX; x <= maxX; x++ )
+	{
+		for ( int y = minY; y <= maxY; y++ )
+		{
+			// nothing will be rebuilt where there is no tile
+			const dtMeshTile *tiles[ 1 ];
+
+			if ( nav->mesh->getTilesAt( x, y, tiles, 1 ) )
+			{
+				graph.dirtyColumns.insert( PackColumn( x, y ) );
+			}
+		}
+	}
+}
+
+static bool NextToColumns( const ClusterNode_t &node, const std::unordered_set<int> &columns )
+{
+	for ( int dx = -1; dx <= 1; dx++ )
+	{
+		for ( int dy = -1; dy <= 1; dy++ )
+		{
+			if ( columns.count( PackColumn( node.x + dx, node.y + dy ) ) )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/*
+====================
+BotUpdateClusters
+
+Builds again the nodes of the marked tiles the tile cache has rebuilt, and the
+nodes next to them as their portals lead to the old polygons. Once the tile
+cache is up to date, the marks of the tiles it did not rebuild are dropped.
+====================
+*/
+void BotUpdateClusters( NavData_t *nav, bool upToDate )
+{
+	ClusterGraph_t &graph = clusterGraph[ nav - BotNavData ];
+	const dtNavMesh *mesh = nav->mesh;
+
+	if ( graph.dirtyColumns.empty() || graph.nodes.empty() )
+	{
+		return;
+	}
+
+	std::unordered_set<int> rebuilt;
+
+	// tiles which were removed or replaced, in a single pass whatever the number of marks
+	for ( size_t i = 0; i < graph.nodes.size(); i++ )
+	{
+		const ClusterNode_t &node = graph.nodes[ i ];
+		const dtMeshTile *tile = mesh->getTile( i );
+		dtTileRef current = tile->header ? mesh->getTileRef( tile ) : 0;
+
+		if ( node.ref == current )
+		{
+			continue;
+		}
+
+		if ( node.ref && graph.dirtyColumns.count( PackColumn( node.x, node.y ) ) )
+		{
+			rebuilt.insert( i );
+		}
+
+		if ( tile->header && graph.dirtyColumns.count( PackColumn( tile->header->x, tile->header->y ) ) )
+		{
+			rebuilt.insert( i );
+		}
+	}
+
+	// the tile cache may not have got to the other marks yet
+	if ( upToDate )
+	{
+		graph.dirtyColumns.clear();
+	}
+
+	if ( rebuilt.empty() )
+	{
+		return;
+	}
+
+	std::unordered_set<int> columns;
+
+	for ( int i : rebuilt )
+	{
+		const ClusterNode_t &node = graph.nodes[ i ];
+
+		if ( node.ref )
+		{
+			columns.insert( PackColumn( node.x, node.y ) );
+		}
+
+		BuildNode( mesh, graph, i );
+
+		if ( graph.nodes[ i ].ref )
+		{
+			columns.insert( PackColumn( graph.nodes[ i ].x, graph.nodes[ i ].y ) );
+		}
+	}
+
+	for ( int column : columns )
+	{
+		graph.dirtyColumns.erase( column );
+	}
+
+	// the neighbours, diagonal ones included
+	for ( size_t i = 0; i < graph.nodes.size(); i++ )
+	{
+		const ClusterNode_t &node = graph.nodes[ i ];
+
+		if ( node.ref && !rebuilt.count( i ) && NextToColumns( node, columns ) )
+		{
+			BuildNode( mesh, graph, i );
+		}
+	}
+}
+
+// whether every node was built from the tile which is now at its index
+static bool ClustersMatchTiles( const NavData_t *nav )
+{
+	const ClusterGraph_t &graph = clusterGraph[ nav - BotNavData ];
+
+	for ( size_t i = 0; i < graph.nodes.size(); i++ )
+	{
+		const dtMeshTile *tile = nav->mesh->getTile( i );
+
+		if ( graph.nodes[ i ].ref != ( tile->header ? nav->mesh->getTileRef( tile ) : 0 ) )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+====================
+BotIsLongRoute
+
+Whether a route is planned through the graph of tiles
+====================
+*/
+bool BotIsLongRoute( const NavData_t *nav, dtPolyRef startRef, dtPolyRef endRef )
+{
+	int distance = g_bot_clusterDistance.Get();
+
+	if ( distance <= 0 || clusterGraph[ nav - BotNavData ].nodes.empty() )
+	{
+		return false;
+	}
+
+	const ClusterGraph_t &graph = clusterGraph[ nav - BotNavData ];
+	const ClusterNode_t &start = graph.nodes[ nav->mesh->decodePolyIdTile( startRef ) ];
+	const ClusterNode_t &end = graph.nodes[ nav->mesh->decodePolyIdTile( endRef ) ];
+
+	return std::max( abs( start.x - end.x ), abs( start.y - end.y ) ) >= distance;
+}
+
+// A* on the tiles, fills the portals to go through from the start tile
+static bool FindCoarseRoute( NavData_t *nav, int startTile, int endTile, const float *start, const float *end,
+                             std::vector<const ClusterPortal_t *> &portals )
+{
+	ClusterGraph_t &graph = clusterGraph[ nav - BotNavData ];
+	int generation = ++graph.generation;
+
+	using entry_t = std::pair<float, int>;
+	std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> open;
+
+	ClusterNode_t &first = graph.nodes[ startTile ];
+	first.generation = generation;
+	first.cost = 0;
+	first.parent = -1;
+	first.closed = false;
+	dtVcopy( first.pos, start );
+	open.push( { dtVdist( start, end ), startTile } );
+
+	while ( !open.empty() )
+	{
+		int current = open.top().second;
+		open.pop();
+
+		ClusterNode_t &node = graph.nodes[ current ];
+
+		if ( node.closed )
+		{
+			continue;
+		}
+
+		node.closed = true;
+
+		if ( current == endTile )
+		{
+			for ( int i = endTile; graph.nodes[ i ].parent >= 0; i = graph.nodes[ i ].parent )
+			{
+				const ClusterNode_t &parent = graph.nodes[ graph.nodes[ i ].parent ];
+				portals.push_back( &parent.portals[ graph.nodes[ i ].parentPortal ] );
+			}
+
+			std::reverse( portals.begin(), portals.end() );
+			return true;
+		}
+
+		for ( size_t p = 0; p < node.portals.size(); p++ )
+		{
+			const ClusterPortal_t &portal = node.portals[ p ];
+			ClusterNode_t &next = graph.nodes[ portal.to ];
+
+			if ( !next.ref )
+			{
+				continue;
+			}
+
+			float cost = node.cost + dtVdist( node.pos, portal.pos );
+
+			if ( next.generation == generation && ( next.closed || next.cost <= cost ) )
+			{
+				continue;
+			}
+
+			next.generation = generation;
+			next.cost = cost;
+			next.parent = current;
+			next.parentPortal = p;
+			next.closed = false;
+			dtVcopy( next.pos, portal.pos );
+			open.push( { cost + dtVdist( portal.pos, end ), portal.to } );
+		}
+	}
+
+	return false;
+}
+
+/*
+====================
+BotRouteCheckpoints
+
+Where the searches refining a long route end: the polygon past every few
+portals of its coarse route, then the end of the route. The checkpoints are
+left empty when the route is to be searched as a whole, because it is not long
+or because the graph is behind the tile cache. Fails if the tiles of the start
+and of the end are not linked.
+====================
+*/
+dtStatus BotRouteCheckpoints( NavData_t *nav, dtPolyRef startRef, dtPolyRef endRef, const float *start, const float *end,
+                              std::vector<RouteCheckpoint_t> &checkpoints )
+{
+	checkpoints.clear();
+
+	if ( !BotIsLongRoute( nav, startRef, endRef ) )
+	{
+		return DT_SUCCESS;
+	}
+
+	std::vector<const ClusterPortal_t *> portals;
+	int startTile = nav->mesh->decodePolyIdTile( startRef );
+	int endTile = nav->mesh->decodePolyIdTile( endRef );
+
+	if ( !FindCoarseRoute( nav, startTile, endTile, start, end, portals ) )
+	{
+		// the tiles are not even linked, unless the graph is behind the tile
+		// cache, which the marks may not tell when a tile was rebuilt unexpectedly
+		bool behind = !clusterGraph[ nav - BotNavData ].dirtyColumns.empty() || !ClustersMatchTiles( nav );
+		return behind ? DT_SUCCESS : DT_FAILURE;
+	}
+
+	int segment = g_bot_clusterSegment.Get();
+
+	for ( size_t i = segment; i <= portals.size(); i += segment )
+	{
+		checkpoints.push_back( { portals[ i - 1 ]->toPoly, rVec::Load( portals[ i - 1 ]->toPos ) } );
+	}
+
+	checkpoints.push_back( { endRef, rVec::Load( end ) } );
+	return DT_SUCCESS;
+}
+
+static int NodesExpanded( const NavData_t *nav )
+{
+	return nav->query->getNodePool()->getNodeCount();
+}
+
+// searches the navmesh from checkpoint to checkpoint, the detail bits of the
+// searches are gathered in the returned status
+static dtStatus RefineRoute( NavData_t *nav, const dtQueryFilter *filter, dtPolyRef startRef, const float *start,
+                             const std::vector<RouteCheckpoint_t> &checkpoints,
+                             dtPolyRef *path, int *pathCount, int maxPath, int *expansions )
+{
+	dtPolyRef from = startRef;
+	const float *fromPos = start;
+	int count = 0;
+	dtStatus detail = 0;
+
+	for ( size_t i = 0; ; i++ )
+	{
+		bool last = i + 1 == checkpoints.size();
+		dtPolyRef to = checkpoints[ i ].ref;
+		const float *toPos = checkpoints[ i ].pos;
+
+		// the portal may lead to a tile which has been rebuilt since
+		if ( !nav->mesh->isValidPolyRef( to ) )
+		{
+			return DT_FAILURE;
+		}
+
+		int outCount = 0;
+		dtStatus status = nav->query->findPath( from, to, fromPos, toPos, filter, path + count, &outCount, maxPath - count );
+		*expansions += NodesExpanded( nav );
+
+		// a segment which does not reach its checkpoint is left to a search on the whole route
+		if ( dtStatusFailed( status ) || dtStatusDetail( status, DT_PARTIAL_RESULT ) || !outCount )
+		{
+			return DT_FAILURE;
+		}
+
+		count += outCount;
+		detail |= status & DT_STATUS_DETAIL_MASK;
+
+		// like findPath, the path is cut short when it does not fit
+		if ( last || count >= maxPath )
+		{
+			*pathCount = count;
+			return DT_SUCCESS | detail | ( last ? 0 : DT_BUFFER_TOO_SMALL );
+		}
+
+		// the next segment starts with the junction polygon, it overwrites it
+		from = to;
+		fromPos = toPos;
+		count--;
+	}
+}
+
+/*
+====================
+BotFindPath
+
+findPath on the navmesh of a bot, through the coarse graph for long routes.
+Adds the number of nodes the searches used to expansions.
+====================
+*/
+dtStatus BotFindPath( NavData_t *nav, const dtQueryFilter *filter, dtPolyRef startRef, dtPolyRef endRef,
+                      const float *start, const float *end, dtPolyRef *path, int *pathCount, int maxPath, int *expansions )
+{
+	int unused = 0;
+	expansions = expansions ? expansions : &unused;
+
+	std::vector<RouteCheckpoint_t> checkpoints;
+
+	if ( dtStatusFailed( BotRouteCheckpoints( nav, startRef, endRef, start, end, checkpoints ) ) )
+	{
+		*pathCount = 0;
+		return DT_FAILURE;
+	}
+
+	if ( !checkpoints.empty() )
+	{
+		dtStatus status = RefineRoute( nav, filter, startRef, start, checkpoints, path, pathCount, maxPath, expansions );
+
+		if ( dtStatusSucceed( status ) )
+		{
+			return status;
+		}
+	}
+
+	dtStatus status = nav->query->findPath( startRef, endRef, start, end, filter, path, pathCount, maxPath );
+	*expansions += NodesExpanded( nav );
+	return status;
+}
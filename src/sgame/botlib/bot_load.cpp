@@ -416,11 +416,16 @@ static navMeshStatus_t BotLoadNavMesh( int f, const NavgenConfig &config, const
 	}
 
 	trap_FS_FCloseFile( f );
+
+	BotBuildClusters( nav );
 	return navMeshStatus_t::LOADED;
 }
 
 void G_BotShutdownNav()
 {
+	BotClearRoutes();
+	BotClearClusters();
+
 	for ( int i = 0; i < numNavData; i++ )
 	{
 		NavData_t *nav = &BotNavData[ i ];
@@ -443,6 +448,12 @@ void G_BotShutdownNav()
 			nav->query = nullptr;
 		}
 
+		if ( nav->slicedQuery )
+		{
+			dtFreeNavMeshQuery( nav->slicedQuery );
+			nav->slicedQuery = nullptr;
+		}
+
 		nav->process.con.reset();
 		nav->species = PCL_NONE;
 	}
@@ -496,6 +507,17 @@ navMeshStatus_t G_BotSetupNav( const NavgenConfig &config, class_t species )
 		return navMeshStatus_t::LOAD_FAILED;
 	}
 
+	// a sliced search keeps its nodes between frames, it cannot share the
+	// node pool of the synchronous query
+	nav->slicedQuery = dtAllocNavMeshQuery();
+
+	if ( !nav->slicedQuery
+	     || dtStatusFailed( nav->slicedQuery->init( nav->mesh, g_bot_maxNavNodes.Get() ) ) )
+	{
+		Log::Notice( "Could not init the sliced Detour Navigation Mesh Query for navmesh %s", speciesName );
+		return navMeshStatus_t::LOAD_FAILED;
+	}
+
 	numNavData++;
 	return navMeshStatus_t::LOADED;
 }
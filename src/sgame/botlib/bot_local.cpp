@@ -210,7 +210,7 @@ static dtRouteResult *FindRouteResult( Bot_t *bot, dtPolyRef start )
 	return nullptr;
 }
 
-static void AddRouteResult( Bot_t *bot, dtPolyRef start, dtPolyRef end, dtStatus status )
+void AddRouteResult( Bot_t *bot, dtPolyRef start, dtPolyRef end, dtStatus status )
 {
 	// only store route failures or partial results
 	if ( !dtStatusFailed( status ) && !dtStatusDetail( status, DT_PARTIAL_RESULT ) )
@@ -278,7 +278,17 @@ bool FindRoute( Bot_t *bot, rVec s, botRouteTargetInternal rtarget, bool allowPa
 		}
 	}
 
-	status = bot->nav->query->findPath( startRef, endRef, start, end, &bot->filter, pathPolys, &pathNumPolys, MAX_BOT_PATH );
+	if ( const std::vector<dtPolyRef> *cached = BotCachedRoute( bot->nav, bot->filter, startRef, endRef ) )
+	{
+		status = DT_SUCCESS;
+		pathNumPolys = cached->size();
+		std::copy( cached->begin(), cached->end(), pathPolys );
+	}
+	else
+	{
+		status = BotFindPath( bot->nav, &bot->filter, startRef, endRef, start, end, pathPolys, &pathNumPolys, MAX_BOT_PATH, nullptr );
+		BotCacheRoute( bot->nav, bot->filter, startRef, endRef, status, pathPolys, pathNumPolys );
+	}
 
 	AddRouteResult( bot, startRef, endRef, status );
 
@@ -297,5 +307,7 @@ bool FindRoute( Bot_t *bot, rVec s, botRouteTargetInternal rtarget, bool allowPa
 
 	bot->needReplan = false;
 	bot->offMesh = false;
+	bot->routeRequest = 0; // a queued replan would be outdated
+	bot->routeFailed = false;
 	return true;
 }
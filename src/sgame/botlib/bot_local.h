@@ -65,6 +65,13 @@ struct dtRouteResult
 	bool      invalid;
 };
 
+// end of one of the searches refining a long route, see bot_cluster.cpp
+struct RouteCheckpoint_t
+{
+	dtPolyRef ref;
+	rVec      pos;
+};
+
 struct OffMeshConnection
 {
 	rVec  start;
@@ -169,6 +176,7 @@ struct NavData_t
 	dtTileCache      *cache;
 	dtNavMesh        *mesh;
 	dtNavMeshQuery   *query;
+	dtNavMeshQuery   *slicedQuery; // for the queued replans, see bot_route.cpp
 	NavconMeshProcess process;
 	class_t species;
 };
@@ -190,6 +198,8 @@ struct Bot_t
 	rVec              offMeshEnd;
 	dtPolyRef         offMeshPoly;
 	dtRouteResult     routeResults[ MAX_ROUTE_CACHE ];
+	int               routeRequest; // serial of the queued replan, 0 if none
+	bool              routeFailed;  // the last replan failed
 };
 
 
@@ -221,4 +231,17 @@ bool         PointInPolyExtents( Bot_t *bot, dtPolyRef ref, rVec point, rVec ext
 bool         PointInPoly( Bot_t *bot, dtPolyRef ref, rVec point );
 bool         BotFindNearestPoly( Bot_t *bot, rVec coord, dtPolyRef *nearestPoly, rVec &nearPoint );
 bool         FindRoute( Bot_t *bot, rVec s, botRouteTargetInternal target, bool allowPartial );
+void         AddRouteResult( Bot_t *bot, dtPolyRef start, dtPolyRef end, dtStatus status );
+void         BotRequestRoute( Bot_t *bot, rVec s, botRouteTargetInternal target );
+void         BotClearRoutes();
+const std::vector<dtPolyRef> *BotCachedRoute( NavData_t *nav, const dtQueryFilter &filter, dtPolyRef start, dtPolyRef end );
+void         BotCacheRoute( NavData_t *nav, const dtQueryFilter &filter, dtPolyRef start, dtPolyRef end, dtStatus status, const dtPolyRef *path, int pathNumPolys );
+void         BotInvalidateRoutes( NavData_t *nav, const rVec *bmin, const rVec *bmax );
+void         BotBuildClusters( NavData_t &nav );
+void         BotClearClusters();
+void         BotMarkClustersDirty( NavData_t *nav, const rVec *bmin, const rVec *bmax );
+void         BotUpdateClusters( NavData_t *nav, bool upToDate );
+bool         BotIsLongRoute( const NavData_t *nav, dtPolyRef startRef, dtPolyRef endRef );
+dtStatus     BotRouteCheckpoints( NavData_t *nav, dtPolyRef startRef, dtPolyRef endRef, const float *start, const float *end, std::vector<RouteCheckpoint_t> &checkpoints );
+dtStatus     BotFindPath( NavData_t *nav, const dtQueryFilter *filter, dtPolyRef startRef, dtPolyRef endRef, const float *start, const float *end, dtPolyRef *path, int *pathCount, int maxPath, int *expansions );
 #endif
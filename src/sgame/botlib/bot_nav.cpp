@@ -144,6 +144,8 @@ void G_BotSetNavMesh( gentity_t *ent )
 	bot.needReplan = true;
 	bot.offMesh = false;
 	bot.numCorners = 0;
+	bot.routeRequest = 0;
+	bot.routeFailed = false;
 	memset( bot.routeResults, 0, sizeof( bot.routeResults ) );
 }
 
@@ -238,7 +240,10 @@ bool G_BotPathNextCorner( int botClientNum, glm::vec3 &result )
 	return true;
 }
 
-void G_BotUpdatePath( int botClientNum, const botRouteTarget_t *target, botNavCmd_t *cmd )
+// a replan can be deferred by the caller, the bot then keeps following what
+// is left of its corridor and its havePath is unchanged, as it does while the
+// route queue plans it
+void G_BotUpdatePath( int botClientNum, const botRouteTarget_t *target, botNavCmd_t *cmd, bool replan )
 {
 	rVec spos;
 	rVec epos;
@@ -259,12 +264,23 @@ void G_BotUpdatePath( int botClientNum, const botRouteTarget_t *target, botNavCm
 
 	if ( !bot->offMesh )
 	{
-		if ( bot->needReplan && FindRoute( bot, spos, rtarget, false ) )
+		if ( replan )
 		{
-			bot->needReplan = false;
-		}
+			if ( bot->needReplan && !bot->routeRequest )
+			{
+				BotRequestRoute( bot, spos, rtarget );
+			}
 
-		cmd->havePath = !bot->needReplan;
+			if ( bot->routeFailed )
+			{
+				cmd->havePath = false;
+				bot->routeFailed = false;
+			}
+			else if ( !bot->needReplan )
+			{
+				cmd->havePath = true;
+			}
+		}
 
 		if ( overOffMeshConnectionStart( bot, spos ) )
 		{
@@ -432,6 +448,25 @@ bool G_BotNavTrace( int botClientNum, botTrace_t *trace, const glm::vec3& start,
 std::map<int, saved_obstacle_t> savedObstacles;
 std::map<int, std::array<dtObstacleRef, MAX_NAV_DATA>> obstacleHandles; // handles of detour's obstacles, if any
 
+static void ObstacleBounds( const NavData_t *nav, const glm::vec3 &qmins, const glm::vec3 &qmaxs, rVec &rmins, rVec &rmaxs )
+{
+	const dtTileCacheParams *params = nav->cache->getParams();
+	float offset = params->walkableRadius;
+
+	rmins = rVec( qmins );
+	rmaxs = rVec( qmaxs );
+
+	// offset bbox by agent radius like the navigation mesh was originally made
+	rmins[ 0 ] -= offset;
+	rmins[ 2 ] -= offset;
+
+	rmaxs[ 0 ] += offset;
+	rmaxs[ 2 ] += offset;
+
+	// offset mins down by agent height so obstacles placed on ledges are handled correctly
+	rmins[ 1 ] -= params->walkableHeight;
+}
+
 void G_BotAddObstacle( const glm::vec3 &qmins, const glm::vec3 &qmaxs, int obstacleNum )
 {
 	savedObstacles[obstacleNum] = { navMeshLoaded == navMeshStatus_t::LOADED, { qmins, qmaxs } };
@@ -445,25 +480,14 @@ void G_BotAddObstacle( const glm::vec3 &qmins, const glm::vec3 &qmaxs, int obsta
 	for ( int i = 0; i < numNavData; i++ )
 	{
 		NavData_t *nav = &BotNavData[ i ];
+		rVec rmins, rmaxs;
 
-		const dtTileCacheParams *params = nav->cache->getParams();
-		float offset = params->walkableRadius;
-
-		rVec rmins(qmins);
-		rVec rmaxs(qmaxs);
-
-		// offset bbox by agent radius like the navigation mesh was originally made
-		rmins[ 0 ] -= offset;
-		rmins[ 2 ] -= offset;
-
-		rmaxs[ 0 ] += offset;
-		rmaxs[ 2 ] += offset;
-
-		// offset mins down by agent height so obstacles placed on ledges are handled correctly
-		rmins[ 1 ] -= params->walkableHeight;
+		ObstacleBounds( nav, qmins, qmaxs, rmins, rmaxs );
 
 		// FIXME: check error of addBoxObstacle
 		nav->cache->addBoxObstacle( rmins, rmaxs, &handles[i] );
+		BotInvalidateRoutes( nav, &rmins, &rmaxs );
+		BotMarkClustersDirty( nav, &rmins, &rmaxs );
 	}
 	auto result = obstacleHandles.insert({obstacleNum, std::move(handles)});
 	if ( !result.second )
@@ -488,8 +512,10 @@ void BotAddSavedObstacles()
 
 void G_BotRemoveObstacle( int obstacleNum )
 {
+	Util::optional<bbox_t> bbox;
 	auto obstacle = savedObstacles.find(obstacleNum);
 	if (obstacle != savedObstacles.end()) {
+		bbox = obstacle->second.bbox;
 		savedObstacles.erase(obstacle);
 	}
 
@@ -506,6 +532,20 @@ void G_BotRemoveObstacle( int obstacleNum )
 			if ( handles[i] != (unsigned int)-1 )
 			{
 				nav->cache->removeObstacle( handles[i] );
+
+				// routes may now go where they could not
+				if ( bbox )
+				{
+					rVec rmins, rmaxs;
+					ObstacleBounds( nav, bbox->mins, bbox->maxs, rmins, rmaxs );
+					BotInvalidateRoutes( nav, &rmins, &rmaxs );
+					BotMarkClustersDirty( nav, &rmins, &rmaxs );
+				}
+				else
+				{
+					BotInvalidateRoutes( nav, nullptr, nullptr );
+					BotMarkClustersDirty( nav, nullptr, nullptr );
+				}
 			}
 		}
 		obstacleHandles.erase(iterator);
@@ -517,6 +557,8 @@ void G_BotUpdateObstacles()
 	for ( int i = 0; i < numNavData; i++ )
 	{
 		NavData_t *nav = &BotNavData[ i ];
-		nav->cache->update( 0, nav->mesh );
+		bool upToDate = false;
+		nav->cache->update( 0, nav->mesh, &upToDate );
+		BotUpdateClusters( nav, upToDate );
 	}
 }
@@ -0,0 +1,645 @@
+/*
+===========================================================================
+
+Daemon BSD Source Code
+Copyright (c) 2026 Daemon Developers
+All rights reserved.
+
+This file is part of the Daemon BSD Source Code (Daemon Source Code).
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the Daemon developers nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL DAEMON DEVELOPERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+===========================================================================
+*/
+
+#include "common/Common.h"
+#include "bot_local.h"
+#include "sgame/sg_local.h"
+
+#include <deque>
+#include <list>
+#include <unordered_map>
+
+/*
+====================
+bot_route.cpp
+
+Queue of the routes the bots need to replan, shared by all of them
+
+A bot that strays from its corridor queues a request and keeps following what
+is left of the corridor until the route is delivered. The requests are solved
+with Detour's sliced pathfinding, a few node expansions per frame, so that a
+wave of bots does not stall the server. Long routes are searched the same way,
+one segment of their route on the graph of tiles after the other. Bots starting
+from the same polygon towards the same polygon with the same filter share one
+request.
+
+Goal changes still plan synchronously with FindRoute, the behavior trees need
+to know right away whether a goal can be reached.
+
+Complete routes, whichever way they were planned, are kept in a cache per
+navmesh shared by all the bots, as bots of a class tend to go from the same
+spawn to the same base. A route is dropped when an obstacle is added or
+removed in one of the tiles it crosses.
+====================
+*/
+
+static Cvar::Cvar<int> g_bot_routeIterations( "g_bot_routeIterations",
+	"node expansions per frame for the queued route replans of all bots, 0 to replan synchronously",
+	Cvar::NONE, 1024 );
+
+struct RouteRequest_t
+{
+	int              serial;
+	dtPolyRef        startRef;
+	dtPolyRef        endRef;
+	rVec             start;
+	rVec             end;
+	dtQueryFilter    filter; // the sliced query keeps a pointer to it
+	std::vector<int> clients;
+	bool             started;   // the checkpoints are known
+	bool             searching; // the sliced query runs one of its searches
+
+	// a long route is searched from checkpoint to checkpoint, see
+	// bot_cluster.cpp, other routes have no checkpoints and one search
+	std::vector<RouteCheckpoint_t> checkpoints;
+	size_t                         checkpoint; // end of the running search
+	std::vector<dtPolyRef>         path;       // found by the previous searches
+	dtStatus                       detail;     // their detail bits
+};
+
+// one per navmesh, as each sliced query only runs one search at a time
+static std::deque<RouteRequest_t> routeQueue[ MAX_NAV_DATA ];
+static int lastSerial = 0;
+static int firstNav = 0;
+static int routeDebt = 0; // node expansions past the budget of the last frame
+
+static Cvar::Cvar<int> g_bot_routeCacheSize( "g_bot_routeCacheSize",
+	"number of routes kept per navmesh for all the bots to reuse, 0 to disable", Cvar::NONE, 256 );
+
+struct RouteKey_t
+{
+	dtPolyRef      startRef;
+	dtPolyRef      endRef;
+	unsigned short includeFlags;
+	unsigned short excludeFlags;
+
+	bool operator==( const RouteKey_t &other ) const
+	{
+		return startRef == other.startRef && endRef == other.endRef
+		       && includeFlags == other.includeFlags && excludeFlags == other.excludeFlags;
+	}
+};
+
+struct RouteKeyHash_t
+{
+	size_t operator()( const RouteKey_t &key ) const
+	{
+		size_t hash = std::hash<dtPolyRef>()( key.startRef );
+		hash = hash * 31 + std::hash<dtPolyRef>()( key.endRef );
+		return hash * 31 + ( key.includeFlags << 16 | key.excludeFlags );
+	}
+};
+
+struct CachedRoute_t
+{
+	RouteKey_t             key;
+	std::vector<dtPolyRef> path;
+	std::vector<int>       tiles; // packed tile coordinates the path crosses
+};
+
+struct RouteCache_t
+{
+	std::list<CachedRoute_t> routes; // most recently used first
+	std::unordered_map<RouteKey_t, std::list<CachedRoute_t>::iterator, RouteKeyHash_t> index;
+};
+
+static RouteCache_t routeCache[ MAX_NAV_DATA ];
+
+static struct
+{
+	int lookups;
+	int hits;
+	int stale;       // found but some polygons no longer existed
+	int invalidated; // by obstacles
+} routeCacheStats;
+
+static int PackTile( int x, int y )
+{
+	return ( x & 0xffff ) << 16 | ( y & 0xffff );
+}
+
+static RouteKey_t MakeRouteKey( const dtQueryFilter &filter, dtPolyRef start, dtPolyRef end )
+{
+	return { start, end, filter.getIncludeFlags(), filter.getExcludeFlags() };
+}
+
+static void EraseRoute( RouteCache_t &cache, std::list<CachedRoute_t>::iterator it )
+{
+	cache.index.erase( it->key );
+	cache.routes.erase( it );
+}
+
+/*
+====================
+BotCachedRoute
+
+A complete route from start to end planned by any bot with the same filter
+flags, nullptr if there is none
+====================
+*/
+const std::vector<dtPolyRef> *BotCachedRoute( NavData_t *nav, const dtQueryFilter &filter, dtPolyRef start, dtPolyRef end )
+{
+	if ( g_bot_routeCacheSize.Get() <= 0 )
+	{
+		return nullptr;
+	}
+
+	RouteCache_t &cache = routeCache[ nav - BotNavData ];
+	routeCacheStats.lookups++;
+
+	auto found = cache.index.find( MakeRouteKey( filter, start, end ) );
+
+	if ( found == cache.index.end() )
+	{
+		return nullptr;
+	}
+
+	// obstacles only change the tiles when the tile cache is updated, a
+	// route planned in between may go through polygons which are now gone
+	for ( dtPolyRef ref : found->second->path )
+	{
+		if ( !nav->mesh->isValidPolyRef( ref ) )
+		{
+			routeCacheStats.stale++;
+			EraseRoute( cache, found->second );
+			return nullptr;
+		}
+	}
+
+	cache.routes.splice( cache.routes.begin(), cache.routes, found->second );
+	routeCacheStats.hits++;
+	return &cache.routes.front().path;
+}
+
+/*
+====================
+BotCacheRoute
+
+Keeps a route for the other bots, only complete routes are kept as nothing
+tells where the obstacles blocking the others are, nor where a route cut short
+to fit the path buffer would have gone
+====================
+*/
+void BotCacheRoute( NavData_t *nav, const dtQueryFilter &filter, dtPolyRef start, dtPolyRef end,
+                    dtStatus status, const dtPolyRef *path, int pathNumPolys )
+{
+	int size = g_bot_routeCacheSize.Get();
+
+	if ( size <= 0 || dtStatusFailed( status ) || dtStatusDetail( status, DT_PARTIAL_RESULT )
+	     || dtStatusDetail( status, DT_BUFFER_TOO_SMALL ) || !pathNumPolys )
+	{
+		return;
+	}
+
+	RouteCache_t &cache = routeCache[ nav - BotNavData ];
+	RouteKey_t key = MakeRouteKey( filter, start, end );
+	auto found = cache.index.find( key );
+
+	if ( found != cache.index.end() )
+	{
+		EraseRoute( cache, found->second );
+	}
+
+	while ( !cache.routes.empty() && int( cache.routes.size() ) >= size )
+	{
+		EraseRoute( cache, std::prev( cache.routes.end() ) );
+	}
+
+	CachedRoute_t route;
+	route.key = key;
+	route.path.assign( path, path + pathNumPolys );
+
+	for ( int i = 0; i < pathNumPolys; i++ )
+	{
+		const dtMeshTile *tile;
+		const dtPoly *poly;
+
+		if ( dtStatusSucceed( nav->mesh->getTileAndPolyByRef( path[ i ], &tile, &poly ) ) )
+		{
+			int packed = PackTile( tile->header->x, tile->header->y );
+
+			if ( std::find( route.tiles.begin(), route.tiles.end(), packed ) == route.tiles.end() )
+			{
+				route.tiles.push_back( packed );
+			}
+		}
+	}
+
+	cache.routes.push_front( std::move( route ) );
+	cache.index.emplace( key, cache.routes.begin() );
+}
+
+/*
+====================
+BotInvalidateRoutes
+
+Drops the routes crossing the tiles touched by the box, given in recast
+coordinates, or all the routes of the navmesh if there is no box
+====================
+*/
+void BotInvalidateRoutes( NavData_t *nav, const rVec *bmin, const rVec *bmax )
+{
+	RouteCache_t &cache = routeCache[ nav - BotNavData ];
+
+	if ( !bmin || !bmax )
+	{
+		routeCacheStats.invalidated += cache.routes.size();
+		cache.routes.clear();
+		cache.index.clear();
+		return;
+	}
+
+	int minX, minY, maxX, maxY;
+	nav->mesh->calcTileLoc( *bmin, &minX, &minY );
+	nav->mesh->calcTileLoc( *bmax, &maxX, &maxY );
+
+	for ( auto it = cache.routes.begin(); it != cache.routes.end(); )
+	{
+		auto next = std::next( it );
+
+		for ( int packed : it->tiles )
+		{
+			int x = int16_t( packed >> 16 );
+			int y = int16_t( packed & 0xffff );
+
+			if ( x >= minX && x <= maxX && y >= minY && y <= maxY )
+			{
+				routeCacheStats.invalidated++;
+				EraseRoute( cache, it );
+				break;
+			}
+		}
+
+		it = next;
+	}
+}
+
+void BotClearRoutes()
+{
+	for ( std::deque<RouteRequest_t> &queue : routeQueue )
+	{
+		queue.clear();
+	}
+
+	routeDebt = 0;
+
+	for ( RouteCache_t &cache : routeCache )
+	{
+		cache.routes.clear();
+		cache.index.clear();
+	}
+}
+
+std::string G_BotRouteCacheStats( bool reset )
+{
+	if ( reset )
+	{
+		routeCacheStats = {};
+		return "";
+	}
+
+	size_t routes = 0;
+
+	for ( int i = 0; i < numNavData; i++ )
+	{
+		routes += routeCache[ i ].routes.size();
+	}
+
+	return Str::Format( "%d routes cached, %d lookups, %.1f%% hits, %d stale, %d invalidated by obstacles",
+	                    routes, routeCacheStats.lookups,
+	                    routeCacheStats.lookups ? 100.0f * routeCacheStats.hits / routeCacheStats.lookups : 0.0f,
+	                    routeCacheStats.stale, routeCacheStats.invalidated );
+}
+
+/*
+====================
+BotRequestRoute
+
+Queues a replan from s to the target, the bot waits for it in routeRequest
+====================
+*/
+void BotRequestRoute( Bot_t *bot, rVec s, botRouteTargetInternal rtarget )
+{
+	if ( g_bot_routeIterations.Get() <= 0 )
+	{
+		bot->routeFailed = !FindRoute( bot, s, rtarget, false );
+		return;
+	}
+
+	rVec start;
+	rVec end;
+	dtPolyRef startRef, endRef;
+
+	if ( !BotFindNearestPoly( bot, s, &startRef, start ) )
+	{
+		bot->routeFailed = true;
+		return;
+	}
+
+	dtStatus status = bot->nav->query->findNearestPoly( rtarget.pos, rtarget.polyExtents,
+	                                                    &bot->filter, &endRef, end );
+
+	if ( dtStatusFailed( status ) || !endRef )
+	{
+		bot->routeFailed = true;
+		return;
+	}
+
+	if ( const std::vector<dtPolyRef> *path = BotCachedRoute( bot->nav, bot->filter, startRef, endRef ) )
+	{
+		bot->corridor.reset( startRef, start );
+		bot->corridor.setCorridor( end, path->data(), path->size() );
+		bot->needReplan = false;
+		return;
+	}
+
+	std::deque<RouteRequest_t> &queue = routeQueue[ bot->nav - BotNavData ];
+
+	for ( RouteRequest_t &request : queue )
+	{
+		if ( request.startRef == startRef && request.endRef == endRef
+		     && request.filter.getIncludeFlags() == bot->filter.getIncludeFlags()
+		     && request.filter.getExcludeFlags() == bot->filter.getExcludeFlags() )
+		{
+			request.clients.push_back( bot->clientNum );
+			bot->routeRequest = request.serial;
+			return;
+		}
+	}
+
+	// serials are never 0, which means no request
+	lastSerial = lastSerial == std::numeric_limits<int>::max() ? 1 : lastSerial + 1;
+
+	RouteRequest_t request;
+	request.serial = lastSerial;
+	request.startRef = startRef;
+	request.endRef = endRef;
+	request.start = start;
+	request.end = end;
+	request.filter = bot->filter;
+	request.clients.push_back( bot->clientNum );
+	request.started = false;
+	request.searching = false;
+	request.checkpoint = 0;
+	request.detail = 0;
+	queue.push_back( std::move( request ) );
+
+	bot->routeRequest = lastSerial;
+}
+
+static void DeliverRoute( const RouteRequest_t &request, dtStatus status, const dtPolyRef *path, int pathNumPolys )
+{
+	for ( int client : request.clients )
+	{
+		Bot_t *bot = &agents[ client ];
+
+		// the bot got a new goal, changed navmesh or left meanwhile
+		if ( bot->routeRequest != request.serial )
+		{
+			continue;
+		}
+
+		bot->routeRequest = 0;
+		AddRouteResult( bot, request.startRef, request.endRef, status );
+
+		// the corridor will be checked again once the bot has landed
+		if ( bot->offMesh )
+		{
+			continue;
+		}
+
+		if ( dtStatusFailed( status ) || dtStatusDetail( status, DT_PARTIAL_RESULT ) )
+		{
+			bot->routeFailed = true;
+			continue;
+		}
+
+		bot->corridor.reset( request.startRef, request.start );
+		bot->corridor.setCorridor( request.end, path, pathNumPolys );
+		bot->needReplan = false;
+	}
+}
+
+static void FinishRequest( NavData_t *nav, std::deque<RouteRequest_t> &queue, dtStatus status, const dtPolyRef *path, int pathNumPolys )
+{
+	const RouteRequest_t &request = queue.front();
+
+	BotCacheRoute( nav, request.filter, request.startRef, request.endRef, status, path, pathNumPolys );
+	DeliverRoute( request, status, path, pathNumPolys );
+	queue.pop_front();
+}
+
+// drops the checkpoints, the next search goes from the start to the end
+static void SearchWholeRoute( RouteRequest_t &request )
+{
+	request.checkpoints.clear();
+	request.checkpoint = 0;
+	request.path.clear();
+	request.detail = 0;
+}
+
+/*
+====================
+StartSearch
+
+Starts the search of the request's route, or of its next segment
+====================
+*/
+static dtStatus StartSearch( NavData_t *nav, RouteRequest_t &request )
+{
+	if ( request.checkpoints.empty() )
+	{
+		return nav->slicedQuery->initSlicedFindPath( request.startRef, request.endRef,
+		                                             request.start, request.end, &request.filter );
+	}
+
+	dtPolyRef from = request.startRef;
+	const float *fromPos = request.start;
+
+	if ( request.checkpoint > 0 )
+	{
+		from = request.checkpoints[ request.checkpoint - 1 ].ref;
+		fromPos = request.checkpoints[ request.checkpoint - 1 ].pos;
+	}
+
+	const RouteCheckpoint_t &to = request.checkpoints[ request.checkpoint ];
+
+	// the checkpoints may be in tiles which have been rebuilt since
+	if ( !nav->mesh->isValidPolyRef( from ) || !nav->mesh->isValidPolyRef( to.ref ) )
+	{
+		SearchWholeRoute( request );
+		return StartSearch( nav, request );
+	}
+
+	return nav->slicedQuery->initSlicedFindPath( from, to.ref, fromPos, to.pos, &request.filter );
+}
+
+/*
+====================
+FinishSegment
+
+Adds the path found by a search of a long route to the request. Returns true
+once the route is complete, or is as long as the path buffer.
+====================
+*/
+static bool FinishSegment( NavData_t *nav, RouteRequest_t &request, dtStatus status, const dtPolyRef *path, int pathNumPolys )
+{
+	// a segment which does not reach its checkpoint is left to a search on the whole route
+	if ( dtStatusFailed( status ) || dtStatusDetail( status, DT_PARTIAL_RESULT ) || !pathNumPolys )
+	{
+		SearchWholeRoute( request );
+		return false;
+	}
+
+	// the junction polygon ends a segment and starts the next one
+	if ( !request.path.empty() )
+	{
+		request.path.pop_back();
+	}
+
+	request.path.insert( request.path.end(), path, path + pathNumPolys );
+	request.detail |= status & DT_STATUS_DETAIL_MASK;
+	request.checkpoint++;
+
+	if ( request.checkpoint < request.checkpoints.size() && request.path.size() < MAX_BOT_PATH )
+	{
+		return false;
+	}
+
+	// the first segments were found frames ago, obstacles may have changed their tiles
+	for ( dtPolyRef ref : request.path )
+	{
+		if ( !nav->mesh->isValidPolyRef( ref ) )
+		{
+			SearchWholeRoute( request );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+====================
+G_BotUpdateRouteQueue
+
+Advances the searches of the queued routes, the navmeshes take turns starting
+the frame so that none of them is starved. A frame which goes past the budget
+takes the difference from the budget of the next one.
+====================
+*/
+void G_BotUpdateRouteQueue()
+{
+	int budget = g_bot_routeIterations.Get() - routeDebt;
+
+	if ( !numNavData )
+	{
+		return;
+	}
+
+	firstNav = ( firstNav + 1 ) % numNavData;
+
+	for ( int n = 0; n < numNavData && budget > 0; n++ )
+	{
+		NavData_t *nav = &BotNavData[ ( firstNav + n ) % numNavData ];
+		std::deque<RouteRequest_t> &queue = routeQueue[ nav - BotNavData ];
+
+		while ( !queue.empty() && budget > 0 )
+		{
+			RouteRequest_t &request = queue.front();
+			dtPolyRef path[ MAX_BOT_PATH ];
+			int pathNumPolys = 0;
+			dtStatus status;
+
+			// long routes are planned on the graph of tiles first
+			if ( !request.started )
+			{
+				request.started = true;
+				budget--;
+
+				if ( dtStatusFailed( BotRouteCheckpoints( nav, request.startRef, request.endRef,
+				                                          request.start, request.end, request.checkpoints ) ) )
+				{
+					FinishRequest( nav, queue, DT_FAILURE, path, 0 );
+					continue;
+				}
+			}
+
+			if ( !request.searching )
+			{
+				status = StartSearch( nav, request );
+				request.searching = true;
+				budget--;
+			}
+			else
+			{
+				status = DT_IN_PROGRESS;
+			}
+
+			if ( dtStatusInProgress( status ) )
+			{
+				int iterations = 0;
+				status = nav->slicedQuery->updateSlicedFindPath( budget, &iterations );
+				budget -= std::max( iterations, 1 );
+			}
+
+			if ( dtStatusInProgress( status ) )
+			{
+				break;
+			}
+
+			request.searching = false;
+
+			if ( !dtStatusFailed( status ) )
+			{
+				// keeps the partial result flag of the search
+				status = nav->slicedQuery->finalizeSlicedFindPath( path, &pathNumPolys, MAX_BOT_PATH );
+			}
+
+			if ( request.checkpoints.empty() )
+			{
+				FinishRequest( nav, queue, status, path, pathNumPolys );
+			}
+			else if ( FinishSegment( nav, request, status, path, pathNumPolys ) )
+			{
+				// like findPath, the path is cut short when it does not fit
+				bool complete = request.checkpoint == request.checkpoints.size() && request.path.size() <= MAX_BOT_PATH;
+				pathNumPolys = std::min<size_t>( request.path.size(), MAX_BOT_PATH );
+				status = DT_SUCCESS | request.detail | ( complete ? 0 : DT_BUFFER_TOO_SMALL );
+				FinishRequest( nav, queue, status, request.path.data(), pathNumPolys );
+			}
+		}
+	}
+
+	routeDebt = std::max( -budget, 0 );
+}
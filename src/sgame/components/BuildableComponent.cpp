@@ -12,6 +12,12 @@ BuildableComponent::BuildableComponent(Entity& entity, HealthComponent& r_Health
 
 	// TODO: Make power state a member variable.
 	entity.oldEnt->powered = true;
+
+	G_IndexBuildable(entity.oldEnt);
+}
+
+BuildableComponent::~BuildableComponent() {
+	G_UnindexBuildable(entity.oldEnt);
 }
 
 void BuildableComponent::HandlePrepareNetCode() {
@@ -99,7 +105,7 @@ void BuildableComponent::Think(int timeDelta) {
 
 				if (entity.oldEnt->creationTime + constructionTime < level.time) {
 					// Finish construction.
-					state = CONSTRUCTED;
+					SetState(CONSTRUCTED);
 
 					// Award momentum.
 					G_AddMomentumForBuilding(entity.oldEnt);
@@ -159,6 +165,7 @@ void BuildableComponent::SetPowerState(bool powered) {
 	bool wasPowered = entity.oldEnt->powered;
 
 	entity.oldEnt->powered = powered;
+	G_MarkNetCodeDirty(entity.oldEnt);
 
 	if (powered && !wasPowered) {
 		G_SetBuildableAnim(entity.oldEnt, BANIM_POWERUP, false);
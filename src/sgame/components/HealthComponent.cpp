@@ -15,6 +15,7 @@ HealthComponent::HealthComponent(Entity& entity, float maxHealth)
 // TODO: Handle rewards array.
 HealthComponent& HealthComponent::operator=(const HealthComponent& other) {
 	health = (other.health / other.maxHealth) * maxHealth;
+	G_MarkNetCodeDirty(entity.oldEnt);
 	return *this;
 }
 
@@ -44,6 +45,7 @@ void HealthComponent::HandleHeal(float amount, gentity_t* /*source*/) {
 	healthLogger.Debug("Healing: %3.1f (%3.1f → %3.1f)", amount, health, health + amount);
 
 	health += amount;
+	G_MarkNetCodeDirty(entity.oldEnt);
 	ScaleDamageAccounts(amount);
 }
 
@@ -187,6 +189,7 @@ Util::optional<glm::vec3> direction, int flags, meansOfDeath_t meansOfDeath) {
 
 	// Do the damage.
 	health -= take;
+	G_MarkNetCodeDirty(entity.oldEnt);
 
 	// Update team overlay info.
 	if (client) client->pers.infoChangeTime = level.time;
@@ -244,6 +247,7 @@ void HealthComponent::SetHealth(float health) {
 
 	ScaleDamageAccounts(health - this->health);
 	HealthComponent::health = health;
+	G_MarkNetCodeDirty(entity.oldEnt);
 }
 
 void HealthComponent::SetMaxHealth(float maxHealth, bool scaleHealth) {
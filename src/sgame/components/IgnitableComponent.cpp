@@ -76,6 +76,7 @@ void IgnitableComponent::HandleIgnite(gentity_t* fireStarter) {
 	// Start burning on initial ignition.
 	if (!onFire) {
 		onFire = true;
+		G_MarkNetCodeDirty(entity.oldEnt);
 		this->fireStarter = fireStarter;
 
 		fireLogger.Notice("Ignited.");
@@ -116,6 +117,7 @@ void IgnitableComponent::HandleExtinguish(int immunityTime) {
 	if (!onFire) return;
 
 	onFire = false;
+	G_MarkNetCodeDirty(entity.oldEnt);
 	immuneUntil = level.time + immunityTime;
 
 	if (alwaysOnFire) {
@@ -42,7 +42,7 @@ void MGTurretComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t /*meansO
 
 void MGTurretComponent::Think(int timeDelta) {
 	// Reset firing flag for now.
-	firing = false;
+	SetFiring(false);
 
 	if (!GetHumanBuildableComponent().GetBuildableComponent().Active()) {
 		BuildableComponent::lifecycle_t state = GetHumanBuildableComponent().GetBuildableComponent().GetState();
@@ -84,7 +84,7 @@ void MGTurretComponent::Think(int timeDelta) {
 				Shoot();
 			}
 
-			firing = true;
+			SetFiring(true);
 		} else {
 			GetTurretComponent().MoveHeadToTarget(timeDelta);
 		}
@@ -135,3 +135,10 @@ void MGTurretComponent::Shoot() {
 
 	lastShot = level.time;
 }
+
+void MGTurretComponent::SetFiring(bool firing) {
+	if (this->firing == firing) return;
+
+	this->firing = firing;
+	G_MarkNetCodeDirty(entity.oldEnt);
+}
@@ -55,6 +55,8 @@ class MGTurretComponent: public MGTurretComponentBase {
 
 		void Shoot();
 
+		void SetFiring(bool firing);
+
 		bool firing;
 
 		int lastTargetSearch;
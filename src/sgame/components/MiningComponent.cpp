@@ -39,6 +39,7 @@ void MiningComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t /*meansOfD
 	// Efficiency will be zero from now on.
 	currentEfficiency   = 0.0f;
 	predictedEfficiency = 0.0f;
+	G_MarkNetCodeDirty(entity.oldEnt);
 
 	// Inform neighbouring miners so they can react immediately.
 	InformNeighbors();
@@ -92,6 +93,7 @@ void MiningComponent::CalculateEfficiency() {
 		G_Team(entity.oldEnt), VEC2GLM(entity.oldEnt->s.origin), this);
 	currentEfficiency = active ? efficiencies.actual : 0.0f;
 	predictedEfficiency = efficiencies.predicted;
+	G_MarkNetCodeDirty(entity.oldEnt);
 }
 
 void MiningComponent::InformNeighbors() {
@@ -31,7 +31,11 @@ void OvermindComponent::Think(int timeDelta) {
 	Entity* target = FindTarget();
 
 	// Save the target for network transmission.
+	// A target that died or was freed since the last think is dropped here.
 	storedTarget = target ? target->oldEnt : nullptr;
+	if ((target ? target->oldEnt->num() : ENTITYNUM_NONE) != entity.oldEnt->s.otherEntityNum) {
+		G_MarkNetCodeDirty(entity.oldEnt);
+	}
 
 	// If target is an enemy in reach, attack it.
 	// TODO: Add LocationComponent and Utility::Distance.
@@ -73,7 +73,7 @@ void RocketpodComponent::HandleDie(gentity_t* /*killer*/, meansOfDeath_t /*means
 }
 
 void RocketpodComponent::Think(int timeDelta) {
-	firing = false;
+	SetFiring(false);
 
 	if (!GetBuildableComponent().Active()) {
 		BuildableComponent::lifecycle_t state = GetBuildableComponent().GetState();
@@ -83,7 +83,7 @@ void RocketpodComponent::Think(int timeDelta) {
 			GetTurretComponent().MoveHeadToTarget(timeDelta);
 		}
 
-		lockingOn = false;
+		SetLockingOn(false);
 		return;
 	}
 
@@ -93,13 +93,13 @@ void RocketpodComponent::Think(int timeDelta) {
 	if (safeMode) {
 		GetTurretComponent().MoveHeadToTarget(timeDelta);
 
-		lockingOn = false;
+		SetLockingOn(false);
 		return;
 	}
 
 	// Do not move while opening shutters.
 	if (openingShuttersSince + SHUTTER_OPEN_TIME > level.time) {
-		lockingOn = false;
+		SetLockingOn(false);
 		return;
 	}
 
@@ -131,14 +131,14 @@ void RocketpodComponent::Think(int timeDelta) {
 			// Lock onto the target and shoot if lock was held long enough and it's safe to do so.
 			if (lockingOn && safeShot && lockingOnSince + LOCKON_TIME <= level.time) {
 				// The lockon timer has expired and it's safe to shoot, so do so.
-				firing = true;
+				SetFiring(true);
 
 				if (lastShot + ROCKETPOD_ATTACK_PERIOD <= level.time) {
 					Shoot(aimDirection);
 				}
 			} else if (!lockingOn) {
 				// Start lockon when the target can be hit, even if it's not safe to shoot yet.
-				lockingOn      = true;
+				SetLockingOn(true);
 				lockingOnSince = level.time;
 			} else if (!safeShot) {
 				// Reset the lockon timer while it's not safe to shoot.
@@ -150,13 +150,13 @@ void RocketpodComponent::Think(int timeDelta) {
 			// There is an entity target but it cannot yet be hit, so track it.
 			GetTurretComponent().MoveHeadToTarget(timeDelta);
 
-			lockingOn = false;
+			SetLockingOn(false);
 		}
 	} else {
 		// Move head towards a non-entity target.
 		GetTurretComponent().MoveHeadToTarget(timeDelta);
 
-		lockingOn = false;
+		SetLockingOn(false);
 	}
 }
 
@@ -301,3 +301,17 @@ void RocketpodComponent::SetSafeMode(bool on) {
 
 	safeMode = on;
 }
+
+void RocketpodComponent::SetFiring(bool firing) {
+	if (this->firing == firing) return;
+
+	this->firing = firing;
+	G_MarkNetCodeDirty(entity.oldEnt);
+}
+
+void RocketpodComponent::SetLockingOn(bool lockingOn) {
+	if (this->lockingOn == lockingOn) return;
+
+	this->lockingOn = lockingOn;
+	G_MarkNetCodeDirty(entity.oldEnt);
+}
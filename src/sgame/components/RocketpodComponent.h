@@ -73,6 +73,9 @@ class RocketpodComponent: public RocketpodComponentBase {
 		 */
 		void SetSafeMode(bool on);
 
+		void SetFiring(bool firing);
+		void SetLockingOn(bool lockingOn);
+
 		bool firing;
 		bool lockingOn;
 		bool safeMode;
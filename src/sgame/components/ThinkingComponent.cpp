@@ -3,14 +3,55 @@
 
 static Log::Logger thinkLogger("sgame.thinking");
 
+float ThinkingComponent::averageFrameTime = 0;
+int ThinkingComponent::averageFrameTimeRound = -1;
+
 ThinkingComponent::ThinkingComponent(Entity& entity, DeferredFreeingComponent& r_DeferredFreeingComponent)
 	: ThinkingComponentBase(entity, r_DeferredFreeingComponent)
 	, iteratingThinkers(false)
 	, unregisterActiveThinker(false)
-	, averageFrameTime(0)
 	, lastThinkRound(-1)
+	, nextWakeTime(std::numeric_limits<int>::max())
 {}
 
+void ThinkingComponent::UpdateAverageFrameTime() {
+	if (averageFrameTimeRound == level.time) {
+		return;
+	}
+
+	averageFrameTimeRound = level.time;
+
+	int frameTime = level.time - level.previousTime;
+
+	if (!averageFrameTime) {
+		averageFrameTime = frameTime;
+	} else {
+		averageFrameTime = averageFrameTime * (1.0f - averageChangeRate) + frameTime * averageChangeRate;
+	}
+}
+
+/**
+ * @brief The earliest time at which the scheduler of a thinker may want to execute it.
+ *
+ * From then on the scheduler is asked every frame. The schedulers that look ahead by the
+ * average frame time get twice that as a margin, since the average can grow meanwhile.
+ */
+int ThinkingComponent::WakeTime(const thinkRecord_t& record) {
+	int dueTime = record.timestamp + record.period;
+	int margin = 2 * static_cast<int>(std::ceil(averageFrameTime));
+
+	switch (record.scheduler) {
+		case SCHEDULER_AFTER:
+			return dueTime;
+
+		case SCHEDULER_AVERAGE:
+			return dueTime - record.delay - margin;
+
+		default:
+			return dueTime - margin;
+	}
+}
+
 void ThinkingComponent::Think() {
 	int time = level.time;
 
@@ -21,46 +62,56 @@ void ThinkingComponent::Think() {
 
 	lastThinkRound = time;
 
-	int frameTime = level.time - level.previousTime;
+	UpdateAverageFrameTime();
 
-	if (!averageFrameTime) {
-		averageFrameTime = frameTime;
-	} else {
-		averageFrameTime = averageFrameTime * (1.0f - averageChangeRate) + frameTime * averageChangeRate;
+	// None of the thinkers can be due yet.
+	if (time < nextWakeTime) {
+		return;
 	}
 
 	iteratingThinkers = true;
 	for (thinkRecord_t &record : thinkers) {
+		if (time < record.wakeTime) continue;
+
 		int timeDelta = time - record.timestamp;
 
 		int thisFrameExecutionLateness = timeDelta - record.period;
 		int nextFrameExecutionLateness = timeDelta + averageFrameTime - record.period;
 
+		bool execute = true;
+
 		switch (record.scheduler) {
 			case SCHEDULER_AFTER:
-				if (thisFrameExecutionLateness < 0) continue;
+				execute = thisFrameExecutionLateness >= 0;
 				break;
 
 			case SCHEDULER_BEFORE:
-				if (nextFrameExecutionLateness <= 0) continue;
+				execute = nextFrameExecutionLateness > 0;
 				break;
 
 			case SCHEDULER_CLOSEST:
-				if (std::abs(nextFrameExecutionLateness) <
-				    std::abs(thisFrameExecutionLateness)) continue;
+				execute = std::abs(nextFrameExecutionLateness) >=
+				          std::abs(thisFrameExecutionLateness);
 				break;
 
 			case SCHEDULER_AVERAGE:
-				if (std::abs(nextFrameExecutionLateness + record.delay) <
-				    std::abs(thisFrameExecutionLateness + record.delay)) continue;
-				record.delay += thisFrameExecutionLateness;
+				execute = std::abs(nextFrameExecutionLateness + record.delay) >=
+				          std::abs(thisFrameExecutionLateness + record.delay);
+				if (execute) record.delay += thisFrameExecutionLateness;
 				break;
 		}
 
+		if (!execute) {
+			// Close to due, ask again next frame.
+			record.wakeTime = time + 1;
+			continue;
+		}
+
 		thinkLogger.Debug("Calling thinker of period %i with lateness %i.",
 		                  record.period, thisFrameExecutionLateness);
 
 		record.timestamp = time;
+		record.wakeTime = WakeTime(record);
 
 		unregisterActiveThinker = false;
 		record.thinker(timeDelta);
@@ -76,6 +127,11 @@ void ThinkingComponent::Think() {
 	// Add thinkers that were registered during iteration.
 	thinkers.insert(thinkers.end(), newThinkers.begin(), newThinkers.end());
 	newThinkers.clear();
+
+	nextWakeTime = std::numeric_limits<int>::max();
+	for (const thinkRecord_t &record : thinkers) {
+		nextWakeTime = std::min(nextWakeTime, record.wakeTime);
+	}
 }
 
 int ThinkingComponent::GetLastThinkTime() const {
@@ -87,13 +143,17 @@ void ThinkingComponent::RegisterThinker(thinker_t thinker, thinkScheduler_t sche
 	// invalidated.
 	std::vector<thinkRecord_t> *addTo = iteratingThinkers ? &newThinkers : &thinkers;
 
-	addTo->emplace_back(thinkRecord_t{thinker, scheduler, period, level.time, 0, false});
+	thinkRecord_t record{thinker, scheduler, period, level.time, 0, false, 0};
+	record.wakeTime = WakeTime(record);
+	addTo->push_back(record);
+
+	nextWakeTime = std::min(nextWakeTime, record.wakeTime);
 
-	thinkLogger.Notice("Registered thinker of period %i.", period);
+	thinkLogger.Debug("Registered thinker of period %i.", period);
 }
 
 void ThinkingComponent::UnregisterActiveThinker() {
 	unregisterActiveThinker = true;
 
-	thinkLogger.Notice("Unregistered the active thinker.");
+	thinkLogger.Debug("Unregistered the active thinker.");
 }
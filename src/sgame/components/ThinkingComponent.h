@@ -49,8 +49,12 @@ class ThinkingComponent: public ThinkingComponentBase {
 			int timestamp; /**< Time of last thinker execution. */
 			int delay; /**< Summed lateness of previous executions. */
 			bool unregister;
+			int wakeTime; /**< Time from which the scheduler needs to be asked again. */
 		};
 
+		static void UpdateAverageFrameTime();
+		static int WakeTime(const thinkRecord_t& record);
+
 		std::vector<thinkRecord_t> thinkers;
 
 		bool iteratingThinkers;
@@ -58,11 +62,14 @@ class ThinkingComponent: public ThinkingComponentBase {
 
 		bool unregisterActiveThinker;
 
-		float averageFrameTime; /**< Smoothed out average frame time for predictions. */
+		static float averageFrameTime; /**< Smoothed out average frame time for predictions. */
+		static int averageFrameTimeRound; /**< Last time the average was updated. */
 
 		constexpr static float averageChangeRate = 0.1f;
 
 		int lastThinkRound; /**< Used to make sure that we think at most once per frame. */
+
+		int nextWakeTime; /**< Earliest wake time of the thinkers, nothing is due before it. */
 };
 
 #endif // THINKING_COMPONENT_H_
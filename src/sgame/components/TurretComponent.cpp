@@ -3,6 +3,7 @@
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/io.hpp>
 #include "../Entities.h"
+#include "../sg_cm_world.h"
 
 static Log::Logger turretLogger("sgame.turrets");
 
@@ -128,6 +129,8 @@ bool TurretComponent::MoveHeadToTarget(int timeDelta) {
 	}
 
 	if (glm::distance2(oldRelativeAimAngles, relativeAimAngles) > 0.0f) {
+		G_MarkNetCodeDirty(entity.oldEnt);
+
 		turretLogger.Debug(
 			"Aiming. Elapsed: %d ms. Delta: %.2f. Max: %.2f. Old: %s. New: %s. Reached: %s.",
 			timeDelta, deltaAngles, maxAngleChange, oldRelativeAimAngles, relativeAimAngles, targetReached
@@ -200,7 +203,7 @@ bool TurretComponent::TargetValid(Entity& target, bool newTarget) {
 	    (target.oldEnt->flags & FL_NOTARGET) ||
 	    !Entities::OnOpposingTeams(entity, target) ||
 	    G_Distance(entity.oldEnt, target.oldEnt) > range ||
-	    !trap_InPVS(entity.oldEnt->s.origin, target.oldEnt->s.origin)) {
+	    !G_EntitiesInPVS(entity.oldEnt, target.oldEnt)) {
 
 		if (!newTarget) {
 			turretLogger.Verbose("Target lost: Out of range or eliminated.");
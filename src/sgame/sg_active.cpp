@@ -34,6 +34,7 @@ bool ClientInactivityTimer( gentity_t *ent, bool active );
 
 static Cvar::Cvar<float> g_devolveReturnRate(
 	"g_devolveReturnRate", "Evolution points per second returned after devolving", Cvar::NONE, 0.4);
+static Cvar::Cvar<bool> g_unlaggedOverride( "g_unlaggedOverride", "trace unlagged clients at their rewound bounds instead of relinking them", Cvar::NONE, true );
 static Cvar::Cvar<bool> g_remotePoison( "g_remotePoison", "booster gives poison when in heal range", Cvar::NONE, false );
 
 static Cvar::Cvar<bool> g_poisonIgnoreArmor(
@@ -394,9 +395,9 @@ static void ClientImpacts( gentity_t *ent, pmove_t *pm )
 		// if our movement is blocked by another player's real position,
 		// don't use the unlagged position for them because they are
 		// blocking or server-side Pmove() from reaching it
-		if ( other->client && other->client->unlaggedCalc.used )
+		if ( other->client )
 		{
-			other->client->unlaggedCalc.used = false;
+			G_UnlaggedExclude( other );
 		}
 
 		// deal impact and weight damage
@@ -670,7 +671,10 @@ static void SpectatorThink( gentity_t *ent, usercmd_t *ucmd )
 		pm.pointcontents = G_CM_PointContents;
 
 		// Perform a pmove
-		Pmove( &pm );
+		{
+			TRACE_PROFILE_SCOPE();
+			Pmove( &pm );
+		}
 
 		// Save results of pmove
 		VectorCopy( client->ps.origin, ent->s.origin );
@@ -857,7 +861,8 @@ static void BeaconAutoTag( gentity_t *self, int timePassed )
 	AngleVectors( self->client->ps.viewangles, forward, nullptr, nullptr );
 	VectorMA( viewOrigin, 65536, forward, end );
 
-	G_UnlaggedOn( self, viewOrigin, 65536 );
+	// TagTrace also looks around the reticle, rewind everyone in its cone
+	G_UnlaggedOn( self, viewOrigin, end, Beacon::TagTraceRadius( 65536 ) );
 	traceEnt = Beacon::TagTrace( VEC2GLM( viewOrigin ), VEC2GLM( end ), self->s.number, MASK_SHOT, team, true );
 	G_UnlaggedOff( );
 
@@ -879,7 +884,7 @@ static void BeaconAutoTag( gentity_t *self, int timePassed )
 			     Beacon::EntityTaggable( i, team, false ) &&
 			     target != traceEnt &&
 			     DistanceSquared( self->s.origin, target->s.origin ) < rangeSquared &&
-			     trap_InPVSIgnorePortals( self->s.origin, target->s.origin ) &&
+			     G_EntitiesInPVSIgnorePortals( self, target ) &&
 			     ( target->s.eType != entityType_t::ET_BUILDABLE
 			       || G_LineOfSight( self, target, MASK_SOLID, false ) ) )
 			{
@@ -1277,36 +1282,37 @@ static void SendPendingPredictableEvents( playerState_t *ps )
 ==============
  G_UnlaggedStore
 
- Called on every server frame.  Stores position data for the client at that
- into client->unlaggedHist[] and the time into level.unlaggedTimes[].
- This data is used by G_UnlaggedCalc()
+ Called on every server frame.  Stores position data for all the clients
+ into level.unlagged at a new marker, along with the time.
+ This data is used by G_UnlaggedCalc() and G_UnlaggedOn()
 ==============
 */
 void G_UnlaggedStore()
 {
-	int        i = 0;
-	gentity_t  *ent;
-	unlagged_t *save;
+	int               i = 0;
+	gentity_t         *ent;
+	unlaggedHistory_t &hist = level.unlagged;
 
 	if ( !g_unlagged.Get() )
 	{
 		return;
 	}
 
-	level.unlaggedIndex++;
+	hist.index++;
 
-	if ( level.unlaggedIndex >= MAX_UNLAGGED_MARKERS )
+	if ( hist.index >= MAX_UNLAGGED_MARKERS )
 	{
-		level.unlaggedIndex = 0;
+		hist.index = 0;
 	}
 
-	level.unlaggedTimes[ level.unlaggedIndex ] = level.time;
+	int marker = hist.index;
+
+	hist.times[ marker ] = level.time;
 
 	for ( i = 0; i < level.maxclients; i++ )
 	{
 		ent = &g_entities[ i ];
-		save = &ent->client->unlaggedHist[ level.unlaggedIndex ];
-		save->used = false;
+		hist.used[ marker ][ i ] = false;
 
 		if ( !ent->r.linked || !( ent->r.contents & CONTENTS_BODY ) )
 		{
@@ -1318,10 +1324,15 @@ void G_UnlaggedStore()
 			continue;
 		}
 
-		VectorCopy( ent->r.mins, save->mins );
-		VectorCopy( ent->r.maxs, save->maxs );
-		VectorCopy( ent->s.pos.trBase, save->origin );
-		save->used = true;
+		for ( int axis = 0; axis < 3; axis++ )
+		{
+			hist.origin[ marker ][ axis ][ i ] = ent->s.pos.trBase[ axis ];
+			hist.mins[ marker ][ axis ][ i ] = ent->r.mins[ axis ];
+			hist.maxs[ marker ][ axis ][ i ] = ent->r.maxs[ axis ];
+		}
+
+		hist.radius[ marker ][ i ] = std::max( VectorLength( ent->r.mins ), VectorLength( ent->r.maxs ) );
+		hist.used[ marker ][ i ] = true;
 	}
 }
 
@@ -1329,7 +1340,7 @@ void G_UnlaggedStore()
 ==============
  G_UnlaggedClear
 
- Mark all unlaggedHist[] markers for this client invalid.  Useful for
+ Mark all the history markers for this client invalid.  Useful for
  preventing teleporting and death.
 ==============
 */
@@ -1339,23 +1350,49 @@ void G_UnlaggedClear( gentity_t *ent )
 
 	for ( i = 0; i < MAX_UNLAGGED_MARKERS; i++ )
 	{
-		ent->client->unlaggedHist[ i ].used = false;
+		level.unlagged.used[ i ][ ent->num() ] = false;
 	}
 }
 
+// the time G_UnlaggedCalc() rewound to, the clients are only interpolated by
+// G_UnlaggedOn() once a shot can reach them
+static struct
+{
+	int   startIndex;
+	int   stopIndex; // -1 if there is nothing to rewind
+	float lerp;
+	bool  eligible[ MAX_CLIENTS ]; // has history at both markers
+} unlaggedRewind = { 0, -1, 0.0f, {} };
+
+/*
+==============
+ G_UnlaggedExclude
+
+ Keeps a client at its real position for the rest of the command
+==============
+*/
+void G_UnlaggedExclude( gentity_t *ent )
+{
+	unlaggedRewind.eligible[ ent->num() ] = false;
+	ent->client->unlaggedCalc.used = false;
+}
+
 /*
 ==============
  G_UnlaggedCalc
 
- Loops through all active clients and calculates their predicted position
- for time then stores it in client->unlaggedCalc
+ Finds the markers to interpolate between to get the position of the
+ clients at time, and which clients can be rewound.
+ The interpolated positions are computed by G_UnlaggedOn() and stored
+ in client->unlaggedCalc
 ==============
 */
 void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 {
 	int       i = 0;
 	gentity_t *ent;
-	int       startIndex = level.unlaggedIndex;
+	const unlaggedHistory_t &hist = level.unlagged;
+	int       startIndex = hist.index;
 	int       stopIndex = -1;
 	int       frameMsec = 0;
 	float     lerp = 0.5f;
@@ -1365,10 +1402,13 @@ void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 		return;
 	}
 
+	unlaggedRewind.stopIndex = -1;
+
 	// clear any calculated values from a previous run
 	for ( i = 0; i < level.maxclients; i++ )
 	{
 		ent = &g_entities[ i ];
+		unlaggedRewind.eligible[ i ] = false;
 
 		if ( !ent->inuse )
 		{
@@ -1380,7 +1420,7 @@ void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 
 	for ( i = 0; i < MAX_UNLAGGED_MARKERS; i++ )
 	{
-		if ( level.unlaggedTimes[ startIndex ] <= time )
+		if ( hist.times[ startIndex ] <= time )
 		{
 			break;
 		}
@@ -1407,15 +1447,18 @@ void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 	}
 
 	// lerp between two markers
-	frameMsec = level.unlaggedTimes[ stopIndex ] -
-	            level.unlaggedTimes[ startIndex ];
+	frameMsec = hist.times[ stopIndex ] - hist.times[ startIndex ];
 
 	if ( frameMsec > 0 )
 	{
-		lerp = ( float )( time - level.unlaggedTimes[ startIndex ] ) /
+		lerp = ( float )( time - hist.times[ startIndex ] ) /
 		       ( float ) frameMsec;
 	}
 
+	unlaggedRewind.startIndex = startIndex;
+	unlaggedRewind.stopIndex = stopIndex;
+	unlaggedRewind.lerp = lerp;
+
 	for ( i = 0; i < level.maxclients; i++ )
 	{
 		ent = &g_entities[ i ];
@@ -1440,28 +1483,7 @@ void G_UnlaggedCalc( int time, gentity_t *rewindEnt )
 			continue;
 		}
 
-		if ( !ent->client->unlaggedHist[ startIndex ].used )
-		{
-			continue;
-		}
-
-		if ( !ent->client->unlaggedHist[ stopIndex ].used )
-		{
-			continue;
-		}
-
-		// between two unlagged markers
-		VectorLerpTrem( lerp, ent->client->unlaggedHist[ startIndex ].mins,
-		                ent->client->unlaggedHist[ stopIndex ].mins,
-		                ent->client->unlaggedCalc.mins );
-		VectorLerpTrem( lerp, ent->client->unlaggedHist[ startIndex ].maxs,
-		                ent->client->unlaggedHist[ stopIndex ].maxs,
-		                ent->client->unlaggedCalc.maxs );
-		VectorLerpTrem( lerp, ent->client->unlaggedHist[ startIndex ].origin,
-		                ent->client->unlaggedHist[ stopIndex ].origin,
-		                ent->client->unlaggedCalc.origin );
-
-		ent->client->unlaggedCalc.used = true;
+		unlaggedRewind.eligible[ i ] = hist.used[ startIndex ][ i ] && hist.used[ stopIndex ][ i ];
 	}
 }
 
@@ -1491,6 +1513,12 @@ void G_UnlaggedOff()
 			continue;
 		}
 
+		if ( G_CM_ClearBoundsOverride( ent ) )
+		{
+			ent->client->unlaggedBackup.used = false;
+			continue;
+		}
+
 		VectorCopy( ent->client->unlaggedBackup.mins, ent->r.mins );
 		VectorCopy( ent->client->unlaggedBackup.maxs, ent->r.maxs );
 		VectorCopy( ent->client->unlaggedBackup.origin, ent->r.currentOrigin );
@@ -1503,21 +1531,28 @@ void G_UnlaggedOff()
 ==============
  G_UnlaggedOn
 
- Called after G_UnlaggedCalc() to apply the calculated values to all active
- clients.  Once finished tracing, G_UnlaggedOff() must be called to restore
- the clients' position data
+ Called after G_UnlaggedCalc() to apply the calculated values to the
+ clients that a shot from start to end can hit.  Once finished tracing,
+ G_UnlaggedOff() must be called to restore the clients' position data
+
+ radius is the distance from the segment at which a client can still be
+ touched, e.g. the half diagonal of a box trace.  The clients are culled
+ against it with the bounding sphere of their motion between the two
+ markers, and only the remaining ones are interpolated.
 
- As an optimization, all clients that have an unlagged position that is
- not touchable at "range" from "muzzle" will be ignored.  This is required
- to prevent a huge amount of trap_LinkEntity() calls per user cmd.
+ With g_unlaggedOverride, the clients are not moved: their rewound bounds
+ override the real ones in the collision code, which spares relinking them
+ twice per shot. Code reading r.currentOrigin keeps seeing the real position.
 ==============
 */
 
-void G_UnlaggedOn( gentity_t *attacker, const vec3_t muzzle, float range )
+void G_UnlaggedOn( gentity_t *attacker, const vec3_t start, const vec3_t end, float radius )
 {
-	int        i = 0;
-	gentity_t  *ent;
-	unlagged_t *calc;
+	gentity_t               *ent;
+	unlagged_t              *calc;
+	const unlaggedHistory_t &hist = level.unlagged;
+	int                     candidates[ MAX_CLIENTS ];
+	int                     numCandidates = 0;
 
 	if ( !g_unlagged.Get() )
 	{
@@ -1529,16 +1564,61 @@ void G_UnlaggedOn( gentity_t *attacker, const vec3_t muzzle, float range )
 		return;
 	}
 
-	for ( i = 0; i < level.maxclients; i++ )
+	if ( unlaggedRewind.stopIndex == -1 )
 	{
-		ent = &g_entities[ i ];
-		calc = &ent->client->unlaggedCalc;
+		return;
+	}
 
-		if ( !calc->used )
+	const int   a = unlaggedRewind.startIndex;
+	const int   b = unlaggedRewind.stopIndex;
+	const float lerp = unlaggedRewind.lerp;
+
+	vec3_t dir;
+	VectorSubtract( end, start, dir );
+	float lengthSquared = std::max( DotProduct( dir, dir ), 1.0e-6f );
+
+	// swept sphere culling: the rewound origin lies on the segment between
+	// the origins at both markers, so the client is within the sphere
+	// around its middle, grown by the radius of its bounds
+	for ( int i = 0; i < level.maxclients; i++ )
+	{
+		if ( !unlaggedRewind.eligible[ i ] )
+		{
+			continue;
+		}
+
+		vec3_t center, offset;
+		float  motion = 0.0f;
+
+		for ( int axis = 0; axis < 3; axis++ )
+		{
+			float delta = hist.origin[ b ][ axis ][ i ] - hist.origin[ a ][ axis ][ i ];
+			center[ axis ] = hist.origin[ a ][ axis ][ i ] + 0.5f * delta;
+			offset[ axis ] = center[ axis ] - start[ axis ];
+			motion += delta * delta;
+		}
+
+		float reach = 0.5f * sqrtf( motion ) + std::max( hist.radius[ a ][ i ], hist.radius[ b ][ i ] ) + radius;
+		float t = Math::Clamp( DotProduct( offset, dir ) / lengthSquared, 0.0f, 1.0f );
+		vec3_t closest;
+
+		VectorMA( offset, -t, dir, closest );
+
+		if ( DotProduct( closest, closest ) > reach * reach )
 		{
 			continue;
 		}
 
+		candidates[ numCandidates++ ] = i;
+	}
+
+	for ( int n = 0; n < numCandidates; n++ )
+	{
+		int i = candidates[ n ];
+
+		ent = &g_entities[ i ];
+		calc = &ent->client->unlaggedCalc;
+
 		if ( ent->client->unlaggedBackup.used )
 		{
 			continue;
@@ -1549,21 +1629,32 @@ void G_UnlaggedOn( gentity_t *attacker, const vec3_t muzzle, float range )
 			continue;
 		}
 
+		if ( !calc->used )
+		{
+			// between two unlagged markers
+			for ( int axis = 0; axis < 3; axis++ )
+			{
+				calc->origin[ axis ] = hist.origin[ a ][ axis ][ i ]
+				                       + lerp * ( hist.origin[ b ][ axis ][ i ] - hist.origin[ a ][ axis ][ i ] );
+				calc->mins[ axis ] = hist.mins[ a ][ axis ][ i ]
+				                     + lerp * ( hist.mins[ b ][ axis ][ i ] - hist.mins[ a ][ axis ][ i ] );
+				calc->maxs[ axis ] = hist.maxs[ a ][ axis ][ i ]
+				                     + lerp * ( hist.maxs[ b ][ axis ][ i ] - hist.maxs[ a ][ axis ][ i ] );
+			}
+
+			calc->used = true;
+		}
+
 		if ( VectorCompare( ent->r.currentOrigin, calc->origin ) )
 		{
 			continue;
 		}
 
-		if ( muzzle )
+		if ( g_unlaggedOverride.Get() )
 		{
-			float r1 = Distance( calc->origin, calc->maxs );
-			float r2 = Distance( calc->origin, calc->mins );
-			float maxRadius = ( r1 > r2 ) ? r1 : r2;
-
-			if ( Distance( muzzle, calc->origin ) > range + maxRadius )
-			{
-				continue;
-			}
+			G_CM_SetBoundsOverride( ent, calc->origin, calc->mins, calc->maxs );
+			ent->client->unlaggedBackup.used = true;
+			continue;
 		}
 
 		// create a backup of the real positions
@@ -1604,10 +1695,7 @@ void G_UnlaggedOn( gentity_t *attacker, const vec3_t muzzle, float range )
 */
 static void G_UnlaggedDetectCollisions( gentity_t *ent )
 {
-	unlagged_t *calc;
 	trace_t    tr;
-	float      r1, r2;
-	float      range;
 
 	if ( !g_unlagged.Get() )
 	{
@@ -1619,34 +1707,27 @@ static void G_UnlaggedDetectCollisions( gentity_t *ent )
 		return;
 	}
 
-	calc = &ent->client->unlaggedCalc;
-
 	// if the client isn't moving, this is not necessary
 	if ( VectorCompare( ent->client->oldOrigin, ent->client->ps.origin ) )
 	{
 		return;
 	}
 
-	range = Distance( ent->client->oldOrigin, ent->client->ps.origin );
-
-	// increase the range by the player's largest possible radius since it's
-	// the players bounding box that collides, not their origin
-	r1 = Distance( calc->origin, calc->mins );
-	r2 = Distance( calc->origin, calc->maxs );
-	range += ( r1 > r2 ) ? r1 : r2;
+	// the player's bounding box sweeps the move, not just its origin
+	float radius = std::max( VectorLength( ent->r.mins ), VectorLength( ent->r.maxs ) );
 
-	G_UnlaggedOn( ent, ent->client->oldOrigin, range );
+	G_UnlaggedOn( ent, ent->client->oldOrigin, ent->client->ps.origin, radius );
 
 	// TODO: consider using G_Trace2 as this misses players overlapping at the start of the trace
 	trap_Trace( &tr, ent->client->oldOrigin, ent->r.mins, ent->r.maxs,
 	            ent->client->ps.origin, ent->s.number, MASK_PLAYERSOLID, 0 );
 
+	G_UnlaggedOff();
+
 	if ( tr.entityNum >= 0 && tr.entityNum < MAX_CLIENTS )
 	{
-		g_entities[ tr.entityNum ].client->unlaggedCalc.used = false;
+		G_UnlaggedExclude( &g_entities[ tr.entityNum ] );
 	}
-
-	G_UnlaggedOff();
 }
 
 /**
@@ -2082,7 +2163,10 @@ static void ClientThink_real( gentity_t *self )
 	// Do this before Pmove because it is shared code and accesses networked fields.
 	G_PrepareEntityNetCode();
 
-	Pmove( &pm );
+	{
+		TRACE_PROFILE_SCOPE();
+		Pmove( &pm );
+	}
 
 	G_UnlaggedDetectCollisions( self );
 
@@ -2237,22 +2321,25 @@ static void ClientThink_real( gentity_t *self )
 		else
 		{
 			// no entity in front of player - do a small area search
-			for ( ent = nullptr; ( ent = G_IterateEntitiesWithinRadius( ent, VEC2GLM( client->ps.origin ), ENTITY_USE_RANGE ) ); )
-			{
-				if ( ent && ent->use && ent->buildableTeam == client->pers.team)
-				{
-					if ( g_debugEntities.Get() > 1 )
-					{
-						Log::Debug("Calling entity->use after an area-search for %s", etos(ent));
-					}
+			ent = nullptr;
 
-					ent->use( ent, self, self ); // other and activator are the same in this context
+			G_ForEntitiesInRadius( VEC2GLM( client->ps.origin ), ENTITY_USE_RANGE, {}, [&]( gentity_t *entity ) {
+				if ( !ent && entity->use && entity->buildableTeam == client->pers.team )
+				{
+					ent = entity;
+				}
+			} );
 
-					break;
+			if ( ent )
+			{
+				if ( g_debugEntities.Get() > 1 )
+				{
+					Log::Debug("Calling entity->use after an area-search for %s", etos(ent));
 				}
-			}
 
-			if ( !ent && client->pers.team == TEAM_ALIENS )
+				ent->use( ent, self, self ); // other and activator are the same in this context
+			}
+			else if ( client->pers.team == TEAM_ALIENS )
 			{
 				G_TriggerMenu( client->num(), MN_A_INFEST );
 			}
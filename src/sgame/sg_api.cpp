@@ -161,7 +161,7 @@ void trap_UnlinkEntity(gentity_t *ent)
 	G_CM_UnlinkEntity(ent);
 }
 
-int trap_EntitiesInBox(const vec3_t mins, const vec3_t maxs, int *list, int maxcount)
+int ( trap_EntitiesInBox )(const vec3_t mins, const vec3_t maxs, int *list, int maxcount)
 {
 	return G_CM_AreaEntities(mins, maxs, list, maxcount);
 }
@@ -185,16 +185,16 @@ bool trap_EntityContact(const vec3_t mins, const vec3_t maxs, const gentity_t *e
 // `results` is populated according to the trace_t documentation, except there is one additional
 // field, entityNum. If fraction < 1.0, entityNum is the number of the hit entity (ENTITYNUM_WORLD
 // if it hits the level geometry). If fraction == 1.0f, entityNum is ENTITYNUM_NONE.
-void trap_Trace( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs,
+void ( trap_Trace )( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs,
                  const vec3_t end, int passEntityNum, int contentmask, int skipmask )
 {
 	G_CM_Trace(results, start, mins, maxs, end, passEntityNum, contentmask, skipmask, traceType_t::TT_AABB);
 }
 
-void trap_Trace( trace_t *results, const glm::vec3& start, const glm::vec3& mins, const glm::vec3& maxs,
+void ( trap_Trace )( trace_t *results, const glm::vec3& start, const glm::vec3& mins, const glm::vec3& maxs,
                  const glm::vec3& end, int passEntityNum, int contentmask , int skipmask)
 {
-	trap_Trace( results, GLM4READ( start ), GLM4READ( mins ), GLM4READ( maxs ), GLM4READ( end ),
+	( trap_Trace )( results, GLM4READ( start ), GLM4READ( mins ), GLM4READ( maxs ), GLM4READ( end ),
 		passEntityNum, contentmask, skipmask );
 }
 
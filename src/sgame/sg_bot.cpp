@@ -437,11 +437,26 @@ void G_BotThink( gentity_t *self )
 	//MUST be done
 	while ( trap_BotGetServerCommand( self->num(), buf, sizeof( buf ) ) );
 
-	BotSearchForEnemy( self );
+	// the searches are the expensive part of thinking, when it is not the
+	// bot's turn it keeps what it found last time
+	bool fullThink = BotThinksFully( self );
+
+	if ( fullThink )
+	{
+		BotThinkBudgetScope budget;
+
+		BotSearchForEnemy( self );
+
+		// Populate transient caches
+		BotFindClosestBuildings( self );
+		BotFindDamagedFriendlyStructure( self );
+		self->botMind->lastFullThink = level.time;
+	}
+	else
+	{
+		BotRefreshCaches( self );
+	}
 
-	// Populate transient caches
-	BotFindClosestBuildings( self );
-	BotFindDamagedFriendlyStructure( self );
 	BotCalculateStuckTime( self );
 
 	//infinite funds cvar
@@ -472,17 +487,26 @@ void G_BotThink( gentity_t *self )
 		return;
 	}
 
-	// always update the path corridor
+	// always update the path corridor, replans wait for the bot's turn
 	if ( self->botMind->goal.isValid() )
 	{
 		botRouteTarget_t routeTarget;
 		BotTargetToRouteTarget( self, self->botMind->goal, &routeTarget );
-		G_BotUpdatePath( self->s.number, &routeTarget, &self->botMind->m_nav );
+
+		if ( fullThink )
+		{
+			BotThinkBudgetScope budget;
+			G_BotUpdatePath( self->s.number, &routeTarget, &self->botMind->m_nav, true );
+		}
+		else
+		{
+			G_BotUpdatePath( self->s.number, &routeTarget, &self->botMind->m_nav, false );
+		}
 	}
 
 	self->botMind->willSprint( false ); //let the BT decide that
-	AINodeStatus_t status =
-		self->botMind->behaviorTree->run( self, ( AIGenericNode_t * ) self->botMind->behaviorTree );
+	BotForgetConditions( self );
+	AINodeStatus_t status = BotRunBehaviorTree( self, self->botMind->behaviorTree );
 	self->botMind->lastThink = level.time;
 
 	if ( traceClient.Get() == self->num() )
@@ -577,6 +601,7 @@ void G_BotSpectatorThink( gentity_t *self )
 
 	// Reset non-time-dependent alive state
 	self->botMind->lastThink = -999999;
+	self->botMind->lastFullThink = -999999;
 	self->botMind->stuckTime = 0;
 	self->botMind->stuckPosition = {1.0e12f, 1.0e12f, 1.0e12f};
 	self->botMind->futureAimTime = 0;
@@ -627,7 +652,16 @@ void G_BotSelectSpawnClass( gentity_t *self )
 {
 	if ( self->botMind->behaviorTree && self->botMind->behaviorTree->classSelectionTree )
 	{
-		BotEvaluateNode( self, self->botMind->behaviorTree->classSelectionTree );
+		BotForgetConditions( self );
+
+		if ( self->botMind->behaviorTree->classSelectionProgram )
+		{
+			BotRunProgram( self, self->botMind->behaviorTree->classSelectionProgram );
+		}
+		else
+		{
+			BotEvaluateNode( self, self->botMind->behaviorTree->classSelectionTree );
+		}
 	}
 }
 
@@ -852,6 +852,14 @@ AINodeStatus_t BotActionEvolveTo( gentity_t *self, AIGenericNode_t *node )
 	AIActionNode_t *action = ( AIActionNode_t * ) node;
 	class_t c = ( class_t )  AIUnBoxInt( action->params[ 0 ] );
 
+	// evolving is tried again on the bot's turn
+	if ( !BotThinksFully( self ) )
+	{
+		return STATUS_FAILURE;
+	}
+
+	BotThinkBudgetScope budget;
+
 	if ( BotEvolveToClass( self, c ) )
 	{
 		return STATUS_SUCCESS;
@@ -1857,6 +1865,14 @@ AINodeStatus_t BotActionBuy( gentity_t *self, AIGenericNode_t *node )
 
 	if ( self->botMind->currentNode != node )
 	{
+		// going to the armoury needs a route, wait for the bot's turn
+		if ( !BotThinksFully( self ) )
+		{
+			return STATUS_RUNNING;
+		}
+
+		BotThinkBudgetScope budget;
+
 		if ( !BotChangeGoalEntity( self, self->botMind->closestBuildings[ BA_H_ARMOURY ].ent ) )
 		{
 			return STATUS_FAILURE;
@@ -1939,6 +1955,14 @@ AINodeStatus_t BotActionBuyPrimary( gentity_t *self, AIGenericNode_t *node )
 
 	if ( self->botMind->currentNode != node )
 	{
+		// going to the armoury needs a route, wait for the bot's turn
+		if ( !BotThinksFully( self ) )
+		{
+			return STATUS_RUNNING;
+		}
+
+		BotThinkBudgetScope budget;
+
 		if ( !BotChangeGoalEntity( self, self->botMind->closestBuildings[ BA_H_ARMOURY ].ent ) )
 		{
 			return STATUS_FAILURE;
@@ -99,6 +99,8 @@ struct AINodeList_t
 	int numNodes;
 };
 
+struct AIProgram_t;
+
 struct AIBehaviorTree_t
 {
 	AINode_t     type;
@@ -106,6 +108,8 @@ struct AIBehaviorTree_t
 	char name[ MAX_QPATH ];
 	AIGenericNode_t *root;
 	AIGenericNode_t *classSelectionTree; // extra BT for deciding the starting class with spawnAs
+	AIProgram_t *program; // compiled root, if it could be compiled
+	AIProgram_t *classSelectionProgram;
 };
 
 // operations used in condition nodes
@@ -161,6 +165,8 @@ struct AIValueFunc_t
 	AIFunc        func;
 	AIValue_t     *params;
 	int           nparams;
+	const char    *name;
+	bool          stable; // can be memoized until the bot acts
 };
 
 // all ops must conform to this interface
@@ -253,6 +259,15 @@ AINodeStatus_t BotDecoratorMapStatus( gentity_t *self, AIGenericNode_t *node );
 // included behavior trees
 AINodeStatus_t BotBehaviorNode( gentity_t *self, AIGenericNode_t *node );
 
+// compiled behavior trees
+AIProgram_t   *BotCompileNode( AIGenericNode_t *root );
+void           BotFreeProgram( AIProgram_t *program );
+AINodeStatus_t BotRunProgram( gentity_t *self, AIProgram_t *program );
+AINodeStatus_t BotRunBehaviorTree( gentity_t *self, AIBehaviorTree_t *tree );
+std::string    BotProgramProfile( AIProgram_t *program, bool reset );
+void           BotForgetConditions( gentity_t *self );
+std::string    BotConditionMemoProfile( bool reset );
+
 // action nodes
 AINodeStatus_t BotActionChangeGoal( gentity_t *self, AIGenericNode_t *node );
 AINodeStatus_t BotActionMoveToGoal( gentity_t *self, AIGenericNode_t *node );
@@ -91,6 +91,15 @@ struct enemyQueue_t
 	int back;
 };
 
+// a potential target as seen by the bots at the start of a frame
+struct botPerceivedEntity_t
+{
+	gentity_t    *ent;
+	glm::vec3    origin;
+	entityType_t eType;
+	float        score; // priority as an enemy, before accounting for distance
+};
+
 // boolean flags that tells which skill (compétence) the bot has.
 //
 // When you add a skill, add it to the skill tree in sg_bot_skilltree.cpp and
@@ -157,6 +166,7 @@ struct botMemory_t
 	// Alive state, reset when bot spawns {
 		int spawnTime;
 		int lastThink;
+		int lastFullThink; // see G_BotScheduleFrame
 
 		int stuckTime;
 		glm::vec3 stuckPosition;
@@ -191,6 +201,12 @@ public:
 	// Reset every frame *while alive*. Reset when behavior changes. Settable by BT
 	int blackboardTransient; // queryable by other bots
 
+	// Values of the condition functions, valid until the bot acts, see BotForgetConditions {
+		std::vector<double> memoValues;
+		std::vector<int>    memoEpochs;
+		int                 memoEpoch;
+	// }
+
 	// Transient caches. These are populated before each think and valid for only one frame {
 		botEntityAndDistance_t bestEnemy;
 		botEntityAndDistance_t closestDamagedBuilding; // friendly only
@@ -229,7 +245,7 @@ navMeshStatus_t G_BotSetupNav( const NavgenConfig &config, class_t species );
 void G_BotShutdownNav();
 bool G_BotFindRoute( int botClientNum, const botRouteTarget_t *target, bool allowPartial );
 bool G_BotPathNextCorner( int botClientNum, glm::vec3 &result );
-void G_BotUpdatePath( int botClientNum, const botRouteTarget_t *target, botNavCmd_t *cmd );
+void G_BotUpdatePath( int botClientNum, const botRouteTarget_t *target, botNavCmd_t *cmd, bool replan );
 bool G_IsBotOverNavcon( int botClientNum );
 bool G_BotNavTrace( int botClientNum, botTrace_t *botTrace, const glm::vec3& start, const glm::vec3& end );
 glm::vec3 ProjectPointOntoVector( const glm::vec3 &point, const glm::vec3 &linePoint1, const glm::vec3 &linePoint2 );
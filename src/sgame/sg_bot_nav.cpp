@@ -301,7 +301,6 @@ float BotGetGoalRadius( const gentity_t *self )
 
 bool GoalInRange( const gentity_t *self, float r )
 {
-	gentity_t *ent = nullptr;
 	// we don't need to check the goal is valid here
 
 	if ( self->botMind->goal.targetsCoordinates() )
@@ -315,15 +314,14 @@ bool GoalInRange( const gentity_t *self, float r )
 				&& fabsf( deltaPos.z ) <= 90;
 	}
 
-	while ( ( ent = G_IterateEntitiesWithinRadius( ent, VEC2GLM( self->s.origin ), r ) ) )
-	{
-		if ( ent == self->botMind->goal.getTargetedEntity() )
-		{
-			return true;
-		}
-	}
+	const gentity_t *target = self->botMind->goal.getTargetedEntity();
+	bool reached = false;
 
-	return false;
+	G_ForEntitiesInRadius( VEC2GLM( self->s.origin ), r, {}, [&]( gentity_t *entity ) {
+		reached = reached || entity == target;
+	} );
+
+	return reached;
 }
 
 float DistanceToGoal2DSquared( const gentity_t *self )
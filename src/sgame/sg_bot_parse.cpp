@@ -496,49 +496,50 @@ static const struct AIConditionMap_s
 	const char    *name;
 	AIFunc        func;
 	int           nparams;
+	bool          stable; // same result for the same parameters until the bot acts, see BotRunProgram
 } conditionFuncs[] =
 {
 	// It looks like behavior tree function names must be ordered alphabetically.
-	{ "alertedToEnemy",    alertedToEnemy,    0 },
-	{ "aliveTime",         aliveTime,         0 },
-	{ "baseRushScore",     baseRushScore,     0 },
-	{ "blackboardNumTransient", blackboardNumTransient, 1 },
-	{ "buildingIsBurning", buildingIsDamaged, 0 },
-	{ "buildingIsDamaged", buildingIsDamaged, 0 },
-	{ "canEvolveTo",       botCanEvolveTo,    1 },
-	{ "chosenBuildableCost", chosenBuildableCost, 0 },
-	{ "class",             botClass,          0 },
-	{ "cvar",              cvar,              1 },
-	{ "directPathTo",      directPathTo,      1 },
-	{ "distanceTo",        distanceTo,        1 },
-	{ "distanceToSpecifiedPosition", distanceToSpecifiedPosition, 0 },
-	{ "goalBuildingType",  goalBuildingType,  0 },
-	{ "goalIsDead",        goalDead,          0 },
-	{ "goalTeam",          goalTeam,          0 },
-	{ "goalType",          goalType,          0 },
-	{ "haveUpgrade",       haveUpgrade,       1 },
-	{ "haveWeapon",        haveWeapon,        1 },
-	{ "healScore",         healScore,         0 },
-	{ "inAttackRange",     inAttackRange,     1 },
-	{ "isVisible",         isVisible,         1 },
-	{ "levelTime",         levelTime,         0 },
-	{ "matchTime",         matchTime,         0 },
-	{ "momentum",          momentum,          1 },
-	{ "myTimer",           myTimer,           0 },
-	{ "numOurBuildings",   numOurBuildings,   1 },
-	{ "numUsersInTeam",    numUsersInTeam,    0 },
-	{ "percentAmmoClip",   percentAmmoClip,   0 },
-	{ "percentClips",      percentClips,      0 },
-	{ "percentHealth",     percentHealth,     1 },
-	{ "random",            randomChance,      0 },
-	{ "resupplyScore",     resupplyScore,     0 },
-	{ "skill",             botSkill,          0 },
-	{ "stuckTime",         stuckTime,         0 },
-	{ "team",              botTeam,           0 },
-	{ "teamateHasWeapon",  teamateHasWeapon,  1 },
-	{ "timeSinceLastCombat", timeSinceLastCombat, 0 },
-	{ "usableBuildPoints", usableBuildPoints, 0 },
-	{ "weapon",            currentWeapon,     0 }
+	{ "alertedToEnemy",    alertedToEnemy,    0, true },
+	{ "aliveTime",         aliveTime,         0, true },
+	{ "baseRushScore",     baseRushScore,     0, true },
+	{ "blackboardNumTransient", blackboardNumTransient, 1, true },
+	{ "buildingIsBurning", buildingIsDamaged, 0, true },
+	{ "buildingIsDamaged", buildingIsDamaged, 0, true },
+	{ "canEvolveTo",       botCanEvolveTo,    1, true },
+	{ "chosenBuildableCost", chosenBuildableCost, 0, false },
+	{ "class",             botClass,          0, true },
+	{ "cvar",              cvar,              1, true },
+	{ "directPathTo",      directPathTo,      1, true },
+	{ "distanceTo",        distanceTo,        1, true },
+	{ "distanceToSpecifiedPosition", distanceToSpecifiedPosition, 0, true },
+	{ "goalBuildingType",  goalBuildingType,  0, true },
+	{ "goalIsDead",        goalDead,          0, true },
+	{ "goalTeam",          goalTeam,          0, true },
+	{ "goalType",          goalType,          0, true },
+	{ "haveUpgrade",       haveUpgrade,       1, true },
+	{ "haveWeapon",        haveWeapon,        1, true },
+	{ "healScore",         healScore,         0, true },
+	{ "inAttackRange",     inAttackRange,     1, true },
+	{ "isVisible",         isVisible,         1, true },
+	{ "levelTime",         levelTime,         0, true },
+	{ "matchTime",         matchTime,         0, true },
+	{ "momentum",          momentum,          1, true },
+	{ "myTimer",           myTimer,           0, true },
+	{ "numOurBuildings",   numOurBuildings,   1, true },
+	{ "numUsersInTeam",    numUsersInTeam,    0, true },
+	{ "percentAmmoClip",   percentAmmoClip,   0, true },
+	{ "percentClips",      percentClips,      0, true },
+	{ "percentHealth",     percentHealth,     1, true },
+	{ "random",            randomChance,      0, false },
+	{ "resupplyScore",     resupplyScore,     0, true },
+	{ "skill",             botSkill,          0, true },
+	{ "stuckTime",         stuckTime,         0, true },
+	{ "team",              botTeam,           0, true },
+	{ "teamateHasWeapon",  teamateHasWeapon,  1, true },
+	{ "timeSinceLastCombat", timeSinceLastCombat, 0, true },
+	{ "usableBuildPoints", usableBuildPoints, 0, true },
+	{ "weapon",            currentWeapon,     0, true }
 };
 
 static const struct AIOpMap_s
@@ -776,6 +777,8 @@ static AIValueFunc_t *newValueFunc( pc_token_list **list )
 	v.expType = EX_FUNC;
 	v.func =    f->func;
 	v.nparams = f->nparams;
+	v.name =    f->name;
+	v.stable =  f->stable;
 
 	parenBegin = current->next;
 
@@ -1690,6 +1693,17 @@ AIBehaviorTree_t *ReadBehaviorTree( const char *name, AITreeList_t *list )
 	if ( node && current == nullptr )
 	{
 		tree->root = node;
+		tree->program = BotCompileNode( tree->root );
+
+		if ( tree->classSelectionTree )
+		{
+			tree->classSelectionProgram = BotCompileNode( tree->classSelectionTree );
+		}
+
+		if ( !tree->program || ( tree->classSelectionTree && !tree->classSelectionProgram ) )
+		{
+			Log::Warn( "behavior %s could not be compiled, it will be interpreted", name );
+		}
 	}
 	else
 	{
@@ -1916,6 +1930,8 @@ void FreeBehaviorTree( AIBehaviorTree_t *tree )
 {
 	if ( tree )
 	{
+		BotFreeProgram( tree->program );
+		BotFreeProgram( tree->classSelectionProgram );
 		FreeNode(tree->root);
 		FreeNode( tree->classSelectionTree );
 		BG_Free( tree );
@@ -2192,3 +2208,25 @@ std::string G_BotBehaviorToString( Str::StringRef behavior )
 	BotBehaviorToStringRec( tree->root, out, 0 );
 	return out.str();
 }
+
+std::string G_BotBehaviorProfile( Str::StringRef behavior, bool reset )
+{
+	AIBehaviorTree_t *tree = BotBehaviorTree( behavior );
+	if ( tree == nullptr )
+	{
+		return "";
+	}
+	if ( tree->program == nullptr )
+	{
+		return Str::Format( "behavior %s is not compiled\n", tree->name );
+	}
+	std::string out = reset ? Str::Format( "reset the profile of %s\n", tree->name )
+	                        : "    calls       time  node\n";
+	if ( tree->classSelectionProgram != nullptr )
+	{
+		out += BotProgramProfile( tree->classSelectionProgram, reset );
+	}
+	out += BotProgramProfile( tree->program, reset );
+	out += BotConditionMemoProfile( reset );
+	return out;
+}
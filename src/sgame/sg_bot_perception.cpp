@@ -0,0 +1,182 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_bot_perception.cpp -- what the bots of a team can see, shared for a frame
+
+#include "common/Common.h"
+#include "sg_bot_util.h"
+#include "FrameProfile.h"
+
+#include <glm/common.hpp>
+#include <unordered_map>
+
+static Cvar::Cvar<int> g_bot_visibilityCell( "g_bot_visibilityCell",
+	"bots whose eyes are in the same cell of this size share their line of sight tests for a frame, 0 to only reuse a bot's own tests",
+	Cvar::NONE, 32 );
+
+// the potential targets of each team, built by the first bot to look for
+// an enemy in the frame
+static std::vector<botPerceivedEntity_t> perceived[ NUM_TEAMS ];
+static bool perceivedValid = false;
+
+// where a line of sight test was made from: the cell of the eyes of the bot,
+// or the bot itself when the cells are disabled
+struct visibilityKey_t
+{
+	glm::ivec3 cell;
+	int        viewer;
+	int        target;
+
+	bool operator==( const visibilityKey_t &other ) const
+	{
+		return cell == other.cell && viewer == other.viewer && target == other.target;
+	}
+};
+
+struct visibilityKeyHash_t
+{
+	size_t operator()( const visibilityKey_t &key ) const
+	{
+		size_t hash = std::hash<int>()( key.cell.x );
+		hash = hash * 31 + std::hash<int>()( key.cell.y );
+		hash = hash * 31 + std::hash<int>()( key.cell.z );
+		hash = hash * 31 + std::hash<int>()( key.viewer );
+		return hash * 31 + std::hash<int>()( key.target );
+	}
+};
+
+// line of sight tests of the frame, see BotPerceivedIsVisible
+static std::unordered_map<visibilityKey_t, bool, visibilityKeyHash_t> visibilityMemo;
+
+/*
+==============
+ G_BotPerceptionFrame
+
+ Forgets what the bots saw in the previous frame
+==============
+*/
+void G_BotPerceptionFrame()
+{
+	perceivedValid = false;
+	visibilityMemo.clear();
+}
+
+static void BotBuildPerception()
+{
+	FRAME_PROFILE_SCOPE( "BotBuildPerception" );
+
+	for ( std::vector<botPerceivedEntity_t> &list : perceived )
+	{
+		list.clear();
+	}
+
+	for ( gentity_t *ent = g_entities; ent < &g_entities[ level.num_entities ]; ent++ )
+	{
+		if ( !BotEntityIsValidTarget( ent ) )
+		{
+			continue;
+		}
+
+		team_t team = G_Team( ent );
+
+		if ( team == TEAM_NONE )
+		{
+			continue;
+		}
+
+		if ( ent->s.eType == entityType_t::ET_BUILDABLE && !g_bot_attackStruct.Get() )
+		{
+			continue;
+		}
+
+		botPerceivedEntity_t target;
+		target.ent = ent;
+		target.origin = VEC2GLM( ent->s.origin );
+		target.eType = ent->s.eType;
+		target.score = BotGetEnemyBaseScore( ent );
+
+		perceived[ team ].push_back( target );
+	}
+
+	perceivedValid = true;
+}
+
+/*
+==============
+ BotPerceivedEnemies
+
+ The potential targets of the opposing team, as they were when the first bot
+ looked for an enemy in this frame.  Targets may have died since, so they
+ still need to be checked with BotEntityIsValidEnemyTarget.
+==============
+*/
+const std::vector<botPerceivedEntity_t> &BotPerceivedEnemies( const gentity_t *self )
+{
+	if ( !perceivedValid )
+	{
+		BotBuildPerception();
+	}
+
+	return perceived[ G_Team( self ) == TEAM_ALIENS ? TEAM_HUMANS : TEAM_ALIENS ];
+}
+
+/*
+==============
+ BotPerceivedIsVisible
+
+ BotTargetIsVisible with MASK_OPAQUE, memoized for the frame.  Bots looking
+ from the same cell reuse each other's results instead of tracing the same
+ line of sight again.
+==============
+*/
+bool BotPerceivedIsVisible( const gentity_t *self, const botPerceivedEntity_t &target )
+{
+	int cellSize = g_bot_visibilityCell.Get();
+	visibilityKey_t key = { glm::ivec3( 0 ), -1, target.ent->num() };
+
+	if ( cellSize > 0 )
+	{
+		glm::vec3 forward;
+		AngleVectors( VEC2GLM( self->client->ps.viewangles ), &forward, nullptr, nullptr );
+		key.cell = glm::ivec3( glm::floor( G_CalcMuzzlePoint( self, forward ) / float( cellSize ) ) );
+	}
+	else
+	{
+		key.viewer = self->num();
+	}
+
+	auto it = visibilityMemo.find( key );
+
+	if ( it != visibilityMemo.end() )
+	{
+		return it->second;
+	}
+
+	botTarget_t bt;
+	bt = target.ent;
+	bool visible = BotTargetIsVisible( self, bt, MASK_OPAQUE );
+
+	visibilityMemo.emplace( key, visible );
+	return visible;
+}
@@ -0,0 +1,990 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+/*
+======================
+sg_bot_program.cpp
+
+Behavior trees compiled to flat programs
+
+The parser builds a behavior tree as a graph of nodes. Once loaded, a tree is
+compiled into an array of instructions in depth first order: the children of
+an instruction directly follow it and each instruction knows where its
+subtree ends, so walking the children is a matter of jumping from one end to
+the next. Condition expressions are constant folded and compiled to code for
+a small stack machine.
+
+Condition functions marked as stable are memoized per bot: their value is kept
+for identical parameters until the bot runs an action, which is the only way
+the tree changes the state they read.
+
+The instructions keep a pointer to the node they were compiled from. It is
+what BotEvaluateNode would be given, so the running state of the bots and
+the action nodes work the same with both interpreters.
+======================
+*/
+
+#include "common/Common.h"
+#include "sg_bot_ai.h"
+#include "sg_bot_parse.h"
+#include "Entities.h"
+
+#include <chrono>
+#include <unordered_map>
+
+static Cvar::Cvar<bool> g_bot_behaviorProfile( "g_bot_behaviorProfile",
+	"time the nodes of the bots' behavior trees, see behavior_profile", Cvar::NONE, false );
+static Cvar::Cvar<bool> g_bot_memoizeConditions( "g_bot_memoizeConditions",
+	"reuse the values of condition functions until the bot acts", Cvar::NONE, true );
+
+enum class AIOpcode_t
+{
+	SELECTOR,
+	SEQUENCE,
+	FALLBACK,
+	CONCURRENT,
+	CONDITION,
+	INVERT,
+	TIMER,
+	RETURN,
+	MAP_STATUS,
+	BEHAVIOR, // included tree, runs its own program
+	LEAF      // calls the run function of the node
+};
+
+enum class AIExprOpcode_t
+{
+	PUSH,
+	CALL,
+	NOT,
+	BOOL,
+	LESSTHAN,
+	LESSTHANEQUAL,
+	GREATERTHAN,
+	GREATERTHANEQUAL,
+	EQUAL,
+	NEQUAL,
+	AND_JUMP, // jumps with false on the stack if the top is false, else pops it
+	OR_JUMP   // jumps with true on the stack if the top is true, else pops it
+};
+
+struct AIInstruction_t
+{
+	AIOpcode_t      op;
+	int             end; // index past the subtree, the children start right after this
+	int             depth;
+	AIGenericNode_t *node;
+
+	// condition code in AIProgram_t::expr
+	int             exprBegin;
+	int             exprEnd;
+};
+
+struct AIExprInstruction_t
+{
+	AIExprOpcode_t      op;
+	double              value;
+	const AIValueFunc_t *func;
+	int                 memoSlot; // of calls to stable functions, -1 otherwise
+	int                 target; // of jumps
+};
+
+// A call of a function with given parameters. The calls are shared by all the
+// trees, so that identical conditions of different trees use the same slot.
+struct AIMemoSlot_t
+{
+	std::string call;
+	int         calls;
+	int         hits;
+};
+
+static std::vector<AIMemoSlot_t> memoSlots;
+static std::unordered_map<std::string, int> memoSlotIndex;
+
+// deep enough for any sensible condition, deeper ones are not compiled
+static const int MAX_EXPR_STACK = 32;
+
+struct AIProgram_t
+{
+	std::vector<AIInstruction_t>     code;
+	std::vector<AIExprInstruction_t> expr;
+
+	// per instruction, includes the time spent in the children
+	std::vector<int>     calls;
+	std::vector<int64_t> microseconds;
+};
+
+/*
+======================
+Condition expressions
+
+Constant subexpressions are evaluated at compile time, the rest is turned into
+postfix code.  The values are the ones the tree interpreter gets: operators
+give 0 or 1, && and || only evaluate their right side when needed.
+======================
+*/
+
+static bool FoldExpression( AIExpType_t *exp, double &value )
+{
+	if ( *exp == EX_VALUE )
+	{
+		value = AIUnBoxDouble( *( AIValue_t * ) exp );
+		return true;
+	}
+
+	if ( *exp != EX_OP )
+	{
+		return false;
+	}
+
+	AIOp_t *op = ( AIOp_t * ) exp;
+	double a, b;
+
+	if ( isUnaryOp( op->opType ) )
+	{
+		if ( !FoldExpression( ( ( AIUnaryOp_t * ) op )->exp, a ) )
+		{
+			return false;
+		}
+
+		value = a == 0.0;
+		return true;
+	}
+
+	if ( !isBinaryOp( op->opType ) )
+	{
+		value = 0.0;
+		return true;
+	}
+
+	AIBinaryOp_t *o = ( AIBinaryOp_t * ) op;
+
+	if ( !FoldExpression( o->exp1, a ) )
+	{
+		return false;
+	}
+
+	if ( o->opType == OP_AND && a == 0.0 )
+	{
+		value = 0.0;
+		return true;
+	}
+
+	if ( o->opType == OP_OR && a != 0.0 )
+	{
+		value = 1.0;
+		return true;
+	}
+
+	if ( !FoldExpression( o->exp2, b ) )
+	{
+		return false;
+	}
+
+	switch ( o->opType )
+	{
+		case OP_LESSTHAN:         value = a < b; break;
+		case OP_LESSTHANEQUAL:    value = a <= b; break;
+		case OP_GREATERTHAN:      value = a > b; break;
+		case OP_GREATERTHANEQUAL: value = a >= b; break;
+		case OP_EQUAL:            value = a == b; break;
+		case OP_NEQUAL:           value = a != b; break;
+		default:                  value = b != 0.0; break; // && and || reaching their right side
+	}
+
+	return true;
+}
+
+static int MemoSlot( const AIValueFunc_t *func )
+{
+	std::string call = func->name;
+
+	for ( int i = 0; i < func->nparams; i++ )
+	{
+		call += i ? ", " : "( ";
+		call += AIUnBoxString( func->params[ i ] );
+	}
+
+	if ( func->nparams )
+	{
+		call += " )";
+	}
+
+	auto it = memoSlotIndex.find( call );
+
+	if ( it != memoSlotIndex.end() )
+	{
+		return it->second;
+	}
+
+	memoSlots.push_back( { call, 0, 0 } );
+	memoSlotIndex.emplace( call, memoSlots.size() - 1 );
+	return memoSlots.size() - 1;
+}
+
+static void Emit( AIProgram_t *program, AIExprOpcode_t op, int &height, int change )
+{
+	AIExprInstruction_t ins{};
+	ins.op = op;
+	program->expr.push_back( ins );
+	height += change;
+}
+
+static bool CompileExpression( AIProgram_t *program, AIExpType_t *exp, int &height, int &maxHeight )
+{
+	double value;
+
+	if ( FoldExpression( exp, value ) )
+	{
+		Emit( program, AIExprOpcode_t::PUSH, height, 1 );
+		program->expr.back().value = value;
+	}
+	else if ( *exp == EX_FUNC )
+	{
+		const AIValueFunc_t *func = ( const AIValueFunc_t * ) exp;
+
+		Emit( program, AIExprOpcode_t::CALL, height, 1 );
+		program->expr.back().func = func;
+		program->expr.back().memoSlot = func->stable ? MemoSlot( func ) : -1;
+	}
+	else if ( isUnaryOp( ( ( AIOp_t * ) exp )->opType ) )
+	{
+		if ( !CompileExpression( program, ( ( AIUnaryOp_t * ) exp )->exp, height, maxHeight ) )
+		{
+			return false;
+		}
+
+		Emit( program, AIExprOpcode_t::NOT, height, 0 );
+	}
+	else
+	{
+		AIBinaryOp_t *o = ( AIBinaryOp_t * ) exp;
+
+		if ( o->opType == OP_AND || o->opType == OP_OR )
+		{
+			double first;
+
+			// a constant left side lets the right side through, see FoldExpression
+			if ( FoldExpression( o->exp1, first ) )
+			{
+				if ( !CompileExpression( program, o->exp2, height, maxHeight ) )
+				{
+					return false;
+				}
+
+				Emit( program, AIExprOpcode_t::BOOL, height, 0 );
+				return true;
+			}
+
+			if ( !CompileExpression( program, o->exp1, height, maxHeight ) )
+			{
+				return false;
+			}
+
+			int jump = program->expr.size();
+			Emit( program, o->opType == OP_AND ? AIExprOpcode_t::AND_JUMP : AIExprOpcode_t::OR_JUMP, height, -1 );
+
+			if ( !CompileExpression( program, o->exp2, height, maxHeight ) )
+			{
+				return false;
+			}
+
+			Emit( program, AIExprOpcode_t::BOOL, height, 0 );
+			program->expr[ jump ].target = program->expr.size();
+		}
+		else
+		{
+			if ( !CompileExpression( program, o->exp1, height, maxHeight ) ||
+			     !CompileExpression( program, o->exp2, height, maxHeight ) )
+			{
+				return false;
+			}
+
+			AIExprOpcode_t op;
+
+			switch ( o->opType )
+			{
+				case OP_LESSTHAN:         op = AIExprOpcode_t::LESSTHAN; break;
+				case OP_LESSTHANEQUAL:    op = AIExprOpcode_t::LESSTHANEQUAL; break;
+				case OP_GREATERTHAN:      op = AIExprOpcode_t::GREATERTHAN; break;
+				case OP_GREATERTHANEQUAL: op = AIExprOpcode_t::GREATERTHANEQUAL; break;
+				case OP_EQUAL:            op = AIExprOpcode_t::EQUAL; break;
+				default:                  op = AIExprOpcode_t::NEQUAL; break;
+			}
+
+			Emit( program, op, height, -1 );
+		}
+	}
+
+	maxHeight = std::max( maxHeight, height );
+	return maxHeight <= MAX_EXPR_STACK;
+}
+
+/*
+======================
+BotForgetConditions
+
+Drops the memoized values of the condition functions, to be called whenever
+the state of the bot may have changed
+======================
+*/
+void BotForgetConditions( gentity_t *self )
+{
+	self->botMind->memoEpoch++;
+}
+
+static double Call( gentity_t *self, const AIExprInstruction_t &ins )
+{
+	botMemory_t *mind = self->botMind;
+	int slot = ins.memoSlot;
+	bool memoize = slot >= 0 && g_bot_memoizeConditions.Get();
+
+	if ( memoize )
+	{
+		memoSlots[ slot ].calls++;
+
+		if ( size_t( slot ) < mind->memoEpochs.size() && mind->memoEpochs[ slot ] == mind->memoEpoch )
+		{
+			memoSlots[ slot ].hits++;
+			return mind->memoValues[ slot ];
+		}
+	}
+
+	AIValue_t v = ins.func->func( self, ins.func->params );
+	double value = AIUnBoxDouble( v );
+	AIDestroyValue( v );
+
+	if ( memoize )
+	{
+		if ( size_t( slot ) >= mind->memoEpochs.size() )
+		{
+			mind->memoEpochs.resize( memoSlots.size(), -1 );
+			mind->memoValues.resize( memoSlots.size() );
+		}
+
+		mind->memoEpochs[ slot ] = mind->memoEpoch;
+		mind->memoValues[ slot ] = value;
+	}
+
+	return value;
+}
+
+static bool RunExpression( gentity_t *self, const AIProgram_t *program, int begin, int end )
+{
+	double stack[ MAX_EXPR_STACK ];
+	int    top = 0;
+
+	for ( int pc = begin; pc < end; pc++ )
+	{
+		const AIExprInstruction_t &ins = program->expr[ pc ];
+
+		switch ( ins.op )
+		{
+			case AIExprOpcode_t::PUSH:
+				stack[ top++ ] = ins.value;
+				break;
+			case AIExprOpcode_t::CALL:
+				stack[ top++ ] = Call( self, ins );
+				break;
+			case AIExprOpcode_t::NOT:
+				stack[ top - 1 ] = stack[ top - 1 ] == 0.0;
+				break;
+			case AIExprOpcode_t::BOOL:
+				stack[ top - 1 ] = stack[ top - 1 ] != 0.0;
+				break;
+			case AIExprOpcode_t::LESSTHAN:
+				top--;
+				stack[ top - 1 ] = stack[ top - 1 ] < stack[ top ];
+				break;
+			case AIExprOpcode_t::LESSTHANEQUAL:
+				top--;
+				stack[ top - 1 ] = stack[ top - 1 ] <= stack[ top ];
+				break;
+			case AIExprOpcode_t::GREATERTHAN:
+				top--;
+				stack[ top - 1 ] = stack[ top - 1 ] > stack[ top ];
+				break;
+			case AIExprOpcode_t::GREATERTHANEQUAL:
+				top--;
+				stack[ top - 1 ] = stack[ top - 1 ] >= stack[ top ];
+				break;
+			case AIExprOpcode_t::EQUAL:
+				top--;
+				stack[ top - 1 ] = stack[ top - 1 ] == stack[ top ];
+				break;
+			case AIExprOpcode_t::NEQUAL:
+				top--;
+				stack[ top - 1 ] = stack[ top - 1 ] != stack[ top ];
+				break;
+			case AIExprOpcode_t::AND_JUMP:
+				if ( stack[ top - 1 ] == 0.0 )
+				{
+					pc = ins.target - 1;
+				}
+				else
+				{
+					top--;
+				}
+				break;
+			case AIExprOpcode_t::OR_JUMP:
+				if ( stack[ top - 1 ] != 0.0 )
+				{
+					stack[ top - 1 ] = 1.0;
+					pc = ins.target - 1;
+				}
+				else
+				{
+					top--;
+				}
+				break;
+		}
+	}
+
+	return stack[ 0 ] != 0.0;
+}
+
+/*
+======================
+Compilation
+======================
+*/
+
+static bool CompileNode( AIProgram_t *program, AIGenericNode_t *node, int depth )
+{
+	int index = program->code.size();
+	AIInstruction_t ins{};
+
+	ins.op = AIOpcode_t::LEAF;
+	ins.node = node;
+	ins.depth = depth;
+
+	// reserve the slot, the children go after it
+	program->code.push_back( ins );
+
+	switch ( node->type )
+	{
+		case SELECTOR_NODE:
+		{
+			AINodeList_t *list = ( AINodeList_t * ) node;
+
+			if ( list->run == BotSelectorNode )
+			{
+				ins.op = AIOpcode_t::SELECTOR;
+			}
+			else if ( list->run == BotSequenceNode )
+			{
+				ins.op = AIOpcode_t::SEQUENCE;
+			}
+			else if ( list->run == BotFallbackNode )
+			{
+				ins.op = AIOpcode_t::FALLBACK;
+			}
+			else if ( list->run == BotConcurrentNode )
+			{
+				ins.op = AIOpcode_t::CONCURRENT;
+			}
+			else
+			{
+				break;
+			}
+
+			for ( int i = 0; i < list->numNodes; i++ )
+			{
+				if ( !CompileNode( program, list->list[ i ], depth + 1 ) )
+				{
+					return false;
+				}
+			}
+			break;
+		}
+
+		case CONDITION_NODE:
+		{
+			AIConditionNode_t *con = ( AIConditionNode_t * ) node;
+			int height = 0, maxHeight = 0;
+
+			ins.op = AIOpcode_t::CONDITION;
+			ins.exprBegin = program->expr.size();
+
+			if ( !CompileExpression( program, con->exp, height, maxHeight ) )
+			{
+				return false;
+			}
+
+			ins.exprEnd = program->expr.size();
+
+			if ( con->child && !CompileNode( program, con->child, depth + 1 ) )
+			{
+				return false;
+			}
+			break;
+		}
+
+		case DECORATOR_NODE:
+		{
+			AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) node;
+
+			if ( dec->run == BotDecoratorInvert )
+			{
+				ins.op = AIOpcode_t::INVERT;
+			}
+			else if ( dec->run == BotDecoratorTimer )
+			{
+				ins.op = AIOpcode_t::TIMER;
+			}
+			else if ( dec->run == BotDecoratorReturn )
+			{
+				ins.op = AIOpcode_t::RETURN;
+			}
+			else if ( dec->run == BotDecoratorMapStatus )
+			{
+				ins.op = AIOpcode_t::MAP_STATUS;
+			}
+			else
+			{
+				break;
+			}
+
+			if ( !CompileNode( program, dec->child, depth + 1 ) )
+			{
+				return false;
+			}
+			break;
+		}
+
+		case BEHAVIOR_NODE:
+			ins.op = AIOpcode_t::BEHAVIOR;
+			break;
+
+		default:
+			break;
+	}
+
+	ins.end = program->code.size();
+	program->code[ index ] = ins;
+	return true;
+}
+
+/*
+======================
+BotCompileNode
+
+Compiles the tree below a node, returns nullptr if it can't be compiled,
+in which case the tree should be run with BotEvaluateNode
+======================
+*/
+AIProgram_t *BotCompileNode( AIGenericNode_t *root )
+{
+	auto *program = new AIProgram_t;
+
+	if ( !CompileNode( program, root, 0 ) )
+	{
+		delete program;
+		return nullptr;
+	}
+
+	program->calls.assign( program->code.size(), 0 );
+	program->microseconds.assign( program->code.size(), 0 );
+	return program;
+}
+
+void BotFreeProgram( AIProgram_t *program )
+{
+	delete program;
+}
+
+/*
+======================
+Execution
+======================
+*/
+
+static AINodeStatus_t RunInstruction( gentity_t *self, AIProgram_t *program, int index );
+
+static bool NodeIsRunning( gentity_t *self, AIGenericNode_t *node )
+{
+	auto &nodes = self->botMind->runningNodes;
+	return std::find( nodes.begin(), nodes.end(), node ) != nodes.end();
+}
+
+// the status of the node itself, BotEvaluateNode minus the running state bookkeeping
+static AINodeStatus_t Dispatch( gentity_t *self, AIProgram_t *program, int index )
+{
+	const AIInstruction_t &ins = program->code[ index ];
+	const AIInstruction_t *code = program->code.data();
+	int firstChild = index + 1;
+
+	switch ( ins.op )
+	{
+		case AIOpcode_t::SELECTOR:
+			for ( int child = firstChild; child < ins.end; child = code[ child ].end )
+			{
+				AINodeStatus_t status = RunInstruction( self, program, child );
+				if ( status != STATUS_FAILURE )
+				{
+					return status;
+				}
+			}
+			return STATUS_FAILURE;
+
+		case AIOpcode_t::SEQUENCE:
+		case AIOpcode_t::FALLBACK:
+		{
+			// find a previously running node and start there
+			int children[ MAX_NODE_LIST ];
+			int numChildren = 0;
+			int start = 0;
+
+			for ( int child = firstChild; child < ins.end; child = code[ child ].end )
+			{
+				children[ numChildren++ ] = child;
+			}
+
+			for ( int i = numChildren - 1; i > 0; i-- )
+			{
+				if ( NodeIsRunning( self, code[ children[ i ] ].node ) )
+				{
+					start = i;
+					break;
+				}
+			}
+
+			// a sequence goes on while its children succeed, a fallback while they fail
+			AINodeStatus_t next = ins.op == AIOpcode_t::SEQUENCE ? STATUS_SUCCESS : STATUS_FAILURE;
+
+			for ( int i = start; i < numChildren; i++ )
+			{
+				AINodeStatus_t status = RunInstruction( self, program, children[ i ] );
+				if ( status != next )
+				{
+					return status;
+				}
+			}
+			return next;
+		}
+
+		case AIOpcode_t::CONCURRENT:
+		{
+			AINodeStatus_t result = STATUS_SUCCESS;
+
+			for ( int child = firstChild; child < ins.end; child = code[ child ].end )
+			{
+				AINodeStatus_t status = RunInstruction( self, program, child );
+
+				if ( status == STATUS_FAILURE )
+				{
+					return STATUS_FAILURE;
+				}
+				else if ( status == STATUS_RUNNING )
+				{
+					result = STATUS_RUNNING;
+				}
+			}
+			return result;
+		}
+
+		case AIOpcode_t::CONDITION:
+			if ( !RunExpression( self, program, ins.exprBegin, ins.exprEnd ) )
+			{
+				return STATUS_FAILURE;
+			}
+
+			if ( firstChild < ins.end )
+			{
+				return RunInstruction( self, program, firstChild );
+			}
+			return STATUS_SUCCESS;
+
+		case AIOpcode_t::INVERT:
+		{
+			AINodeStatus_t status = RunInstruction( self, program, firstChild );
+
+			if ( status == STATUS_SUCCESS )
+				return STATUS_FAILURE;
+
+			if ( status == STATUS_FAILURE )
+				return STATUS_SUCCESS;
+
+			return status;
+		}
+
+		case AIOpcode_t::TIMER:
+		{
+			AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) ins.node;
+
+			if ( level.time > dec->data[ self->s.number ] )
+			{
+				AINodeStatus_t status = RunInstruction( self, program, firstChild );
+
+				if ( status == STATUS_FAILURE )
+				{
+					dec->data[ self->s.number ] = level.time + AIUnBoxInt( dec->params[ 0 ] );
+				}
+
+				return status;
+			}
+			return STATUS_FAILURE;
+		}
+
+		case AIOpcode_t::RETURN:
+		{
+			AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) ins.node;
+
+			RunInstruction( self, program, firstChild );
+			return ( AINodeStatus_t ) AIUnBoxInt( dec->params[ 0 ] );
+		}
+
+		case AIOpcode_t::MAP_STATUS:
+		{
+			AIDecoratorNode_t *dec = ( AIDecoratorNode_t * ) ins.node;
+			AINodeStatus_t result = RunInstruction( self, program, firstChild );
+
+			switch ( result )
+			{
+			case STATUS_FAILURE:
+				return ( AINodeStatus_t ) AIUnBoxInt( dec->params[ 0 ] );
+			case STATUS_SUCCESS:
+				return ( AINodeStatus_t ) AIUnBoxInt( dec->params[ 1 ] );
+			case STATUS_RUNNING:
+				return ( AINodeStatus_t ) AIUnBoxInt( dec->params[ 2 ] );
+			default:
+				return result;
+			}
+		}
+
+		case AIOpcode_t::BEHAVIOR:
+			return BotRunBehaviorTree( self, ( AIBehaviorTree_t * ) ins.node );
+
+		case AIOpcode_t::LEAF:
+			break;
+	}
+
+	AINodeStatus_t status = ins.node->run( self, ins.node );
+	BotForgetConditions( self );
+	return status;
+}
+
+// same as BotEvaluateNode
+static AINodeStatus_t RunInstruction( gentity_t *self, AIProgram_t *program, int index )
+{
+	AIGenericNode_t *node = program->code[ index ].node;
+	AINodeStatus_t status;
+	std::chrono::steady_clock::time_point start;
+	bool timed = g_bot_behaviorProfile.Get();
+
+	if ( timed )
+	{
+		start = std::chrono::steady_clock::now();
+	}
+
+	if ( node->type == AINode_t::ACTION_NODE && !Entities::IsAlive( self ) )
+	{
+		// don't allow actions while dead
+		status = STATUS_FAILURE;
+	}
+	else
+	{
+		status = Dispatch( self, program, index );
+	}
+
+	// reset the current node if it finishes
+	// we do this so we can re-pathfind on the next entrance
+	if ( ( status == STATUS_SUCCESS || status == STATUS_FAILURE ) && self->botMind->currentNode == node )
+	{
+		self->botMind->currentNode = nullptr;
+	}
+
+	// reset running information on node success so sequences and selectors reset their state
+	if ( NodeIsRunning( self, node ) && status == STATUS_SUCCESS )
+	{
+		self->botMind->runningNodes.clear();
+	}
+
+	// store running information for sequence nodes and selector nodes
+	if ( status == STATUS_RUNNING )
+	{
+		// clear out previous running list when we hit a running leaf node
+		// this insures that only 1 node in a sequence or selector has the running state
+		if ( node->type == ACTION_NODE )
+		{
+			self->botMind->runningNodes.clear();
+		}
+
+		if ( !NodeIsRunning( self, node ) )
+		{
+			if ( !self->botMind->runningNodes.append( node ) )
+			{
+				Log::Warn( "Bot failed to execute action: "
+						"MAX_NODE_DEPTH exceeded" );
+			}
+		}
+	}
+
+	program->calls[ index ]++;
+
+	if ( timed )
+	{
+		program->microseconds[ index ] += std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start ).count();
+	}
+
+	return status;
+}
+
+/*
+======================
+BotRunProgram
+
+Evaluates a compiled tree like BotEvaluateNode evaluates its root
+======================
+*/
+AINodeStatus_t BotRunProgram( gentity_t *self, AIProgram_t *program )
+{
+	return RunInstruction( self, program, 0 );
+}
+
+/*
+======================
+BotRunBehaviorTree
+
+Runs the root node of a behavior tree, compiled if possible
+======================
+*/
+AINodeStatus_t BotRunBehaviorTree( gentity_t *self, AIBehaviorTree_t *tree )
+{
+	if ( tree->program )
+	{
+		return BotRunProgram( self, tree->program );
+	}
+
+	AINodeStatus_t status = BotBehaviorNode( self, ( AIGenericNode_t * ) tree );
+	BotForgetConditions( self );
+	return status;
+}
+
+/*
+======================
+Profiling
+======================
+*/
+
+static std::string InstructionName( const AIInstruction_t &ins )
+{
+	switch ( ins.op )
+	{
+		case AIOpcode_t::SELECTOR:   return "selector";
+		case AIOpcode_t::SEQUENCE:   return "sequence";
+		case AIOpcode_t::FALLBACK:   return "fallback";
+		case AIOpcode_t::CONCURRENT: return "concurrent";
+		case AIOpcode_t::CONDITION:  return "condition";
+		case AIOpcode_t::INVERT:     return "decorator invert";
+		case AIOpcode_t::TIMER:      return "decorator timer";
+		case AIOpcode_t::RETURN:     return "decorator return";
+		case AIOpcode_t::MAP_STATUS: return "decorator mapStatus";
+		case AIOpcode_t::BEHAVIOR:
+			return Str::Format( "behavior %s", ( ( AIBehaviorTree_t * ) ins.node )->name );
+		case AIOpcode_t::LEAF:
+			break;
+	}
+
+	switch ( ins.node->type )
+	{
+		case ACTION_NODE:
+		{
+			const AIActionNode_t *action = ( const AIActionNode_t * ) ins.node;
+			return Str::Format( "action %s (line %d)", action->name, action->lineNum );
+		}
+		case SPAWN_NODE:
+			return "spawnAs";
+		default:
+			return "node";
+	}
+}
+
+/*
+======================
+BotProgramProfile
+
+The number of evaluations of each node and, with g_bot_behaviorProfile, the
+time spent in it and its children
+======================
+*/
+std::string BotProgramProfile( AIProgram_t *program, bool reset )
+{
+	std::string out;
+
+	for ( size_t i = 0; i < program->code.size(); i++ )
+	{
+		const AIInstruction_t &ins = program->code[ i ];
+
+		if ( reset )
+		{
+			program->calls[ i ] = 0;
+			program->microseconds[ i ] = 0;
+			continue;
+		}
+
+		out += Str::Format( "%9d %10.3fms  %s%s\n", program->calls[ i ], program->microseconds[ i ] / 1000.0,
+		                    std::string( 2 * ins.depth, ' ' ), InstructionName( ins ) );
+	}
+
+	return out;
+}
+
+/*
+======================
+BotConditionMemoProfile
+
+How often the values of the condition functions were reused
+======================
+*/
+std::string BotConditionMemoProfile( bool reset )
+{
+	std::string out = "\n    calls   hits  condition\n";
+	int calls = 0, hits = 0;
+
+	for ( AIMemoSlot_t &slot : memoSlots )
+	{
+		if ( reset )
+		{
+			slot.calls = slot.hits = 0;
+			continue;
+		}
+
+		if ( slot.calls )
+		{
+			out += Str::Format( "%9d %5.1f%%  %s\n", slot.calls, 100.0f * slot.hits / slot.calls, slot.call );
+			calls += slot.calls;
+			hits += slot.hits;
+		}
+	}
+
+	if ( reset )
+	{
+		return "";
+	}
+
+	out += Str::Format( "%9d %5.1f%%  total\n", calls, calls ? 100.0f * hits / calls : 0.0f );
+	return out;
+}
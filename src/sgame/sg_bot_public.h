@@ -48,6 +48,9 @@ bool G_BotSetBehavior( botMemory_t *botMind, Str::StringRef behavior );
 bool G_BotSetDefaults( int clientNum, team_t team, Str::StringRef behavior );
 void G_BotDel( int clientNum );
 void G_BotDelAllBots();
+void G_BotPerceptionFrame();
+void G_BotScheduleFrame();
+std::string G_BotThinkBudgetStats( bool reset );
 void G_BotThink( gentity_t *self );
 void G_BotSpectatorThink( gentity_t *self );
 void G_BotIntermissionThink( gclient_t *client );
@@ -59,6 +62,8 @@ void G_BotSetNavMesh( gentity_t *ent );
 void G_BotAddObstacle( const glm::vec3 &mins, const glm::vec3 &maxs, int obstacleNum );
 void G_BotRemoveObstacle( int obstacleNum );
 void G_BotUpdateObstacles();
+void G_BotUpdateRouteQueue();
+std::string G_BotRouteCacheStats( bool reset );
 void G_BotBackgroundNavgen();
 bool G_BotInit();
 void G_BotCleanup();
@@ -67,6 +72,7 @@ void G_BotRemoveObstacle( qhandle_t handle );
 void G_BotUpdateObstacles();
 std::string G_BotToString( gentity_t *bot );
 std::string G_BotBehaviorToString( Str::StringRef behavior );
+std::string G_BotBehaviorProfile( Str::StringRef behavior, bool reset );
 
 const char BOT_DEFAULT_BEHAVIOR[] = "default";
 const char BOT_NAME_FROM_LIST[] = "*";
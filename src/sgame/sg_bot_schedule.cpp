@@ -0,0 +1,277 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// sg_bot_schedule.cpp -- which bots do their expensive thinking in a frame
+
+#include "common/Common.h"
+#include "sg_bot_util.h"
+#include "Entities.h"
+
+#include <algorithm>
+
+static Cvar::Cvar<float> g_bot_thinkBudget( "g_bot_thinkBudget",
+	"milliseconds per frame the bots may spend looking for enemies, planning routes, buying and evolving, 0 for no limit",
+	Cvar::NONE, 4.0f );
+static Cvar::Cvar<int> g_bot_thinkInterval( "g_bot_thinkInterval",
+	"longest time in milliseconds a bot near a player goes without thinking fully, whatever the budget",
+	Cvar::NONE, 250 );
+static Cvar::Cvar<float> g_bot_lodDistance( "g_bot_lodDistance",
+	"bots further than this from every player think less often", Cvar::NONE, 2000.0f );
+static Cvar::Cvar<int> g_bot_lodFactor( "g_bot_lodFactor",
+	"how many times less often the distant bots think", Cvar::NONE, 4 );
+static Cvar::Cvar<bool> g_bot_thinkBudgetReport( "g_bot_thinkBudgetReport",
+	"log the frames in which the bots overran g_bot_thinkBudget, see also bot_budget_stats", Cvar::NONE, false );
+
+static struct
+{
+	bool    fullThink[ MAX_CLIENTS ];
+	int     numFullThinks;
+	int     numDeferred;
+	int64_t spent;       // microseconds, this frame
+	int64_t unscheduled; // microseconds, this frame, of the goal changes out of turn
+	float   averageCost; // microseconds per full think
+	float   averageUnscheduled;
+	int     scopeDepth;
+
+	// since the last report
+	int     overruns;
+	int64_t worstOverrun;
+	int     lastReport;
+} schedule;
+
+// since the last reset, see G_BotThinkBudgetStats
+static struct
+{
+	int     frames; // with a budget
+	int     overruns;
+	int64_t worstOverrun;
+	int64_t overrunTime;
+} budgetStats;
+
+/*
+==============
+ BotThinkBudgetScope
+
+ Only the outermost scope counts, the time spent in the scopes it contains
+ is already part of its own.
+==============
+*/
+BotThinkBudgetScope::BotThinkBudgetScope( bool scheduled )
+	: start( std::chrono::steady_clock::now() ), scheduled( scheduled )
+{
+	schedule.scopeDepth++;
+}
+
+BotThinkBudgetScope::~BotThinkBudgetScope()
+{
+	if ( --schedule.scopeDepth )
+	{
+		return;
+	}
+
+	int64_t time = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start ).count();
+
+	schedule.spent += time;
+
+	if ( !scheduled )
+	{
+		schedule.unscheduled += time;
+	}
+}
+
+/*
+==============
+ BotThinksFully
+
+ Whether the bot may look for enemies, plan routes, buy or evolve this frame.
+ Moving and aiming are done every frame regardless.
+==============
+*/
+bool BotThinksFully( const gentity_t *self )
+{
+	return schedule.fullThink[ self->num() ];
+}
+
+static void BotReportBudget( int64_t budget )
+{
+	budgetStats.frames++;
+
+	if ( schedule.spent > budget )
+	{
+		schedule.overruns++;
+		schedule.worstOverrun = std::max( schedule.worstOverrun, schedule.spent - budget );
+
+		budgetStats.overruns++;
+		budgetStats.worstOverrun = std::max( budgetStats.worstOverrun, schedule.spent - budget );
+		budgetStats.overrunTime += schedule.spent - budget;
+	}
+
+	if ( !g_bot_thinkBudgetReport.Get() || level.time - schedule.lastReport < 1000 )
+	{
+		return;
+	}
+
+	if ( schedule.overruns )
+	{
+		Log::Notice( "bots overran their think budget of %.1fms in %d frames, by up to %.1fms, %d bots waiting for their turn",
+		             g_bot_thinkBudget.Get(), schedule.overruns, schedule.worstOverrun / 1000.0f, schedule.numDeferred );
+	}
+
+	schedule.overruns = 0;
+	schedule.worstOverrun = 0;
+	schedule.lastReport = level.time;
+}
+
+std::string G_BotThinkBudgetStats( bool reset )
+{
+	if ( reset )
+	{
+		budgetStats = {};
+		return "";
+	}
+
+	return Str::Format( "%d of %d frames over the budget of %.1fms, by %.2fms on average and up to %.1fms, "
+	                    "%.0fµs per full think, %d bots waiting for their turn",
+	                    budgetStats.overruns, budgetStats.frames, g_bot_thinkBudget.Get(),
+	                    budgetStats.overruns ? budgetStats.overrunTime / 1000.0f / budgetStats.overruns : 0.0f,
+	                    budgetStats.worstOverrun / 1000.0f, schedule.averageCost, schedule.numDeferred );
+}
+
+static bool BotNearPlayer( const gentity_t *self, float range )
+{
+	for ( int i = 0; i < level.maxclients; i++ )
+	{
+		const gclient_t *client = &level.clients[ i ];
+
+		if ( client->pers.connected != CON_CONNECTED || client->pers.isBot
+		     || client->pers.team == TEAM_NONE )
+		{
+			continue;
+		}
+
+		if ( DistanceSquared( self->s.origin, client->ps.origin ) < Square( range ) )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+==============
+ G_BotScheduleFrame
+
+ Picks the bots that think fully in this frame. The bots that waited the
+ longest relatively to their interval go first, as many as the budget is
+ expected to allow from the cost of the previous full thinks. A bot is never
+ kept waiting for more than its interval, which is longer for the bots far
+ from every player.
+
+ The goal changes the behavior trees make out of their bot's turn cannot
+ wait, the budget is shrunk by what they cost in the previous frames.
+==============
+*/
+void G_BotScheduleFrame()
+{
+	int64_t budget = g_bot_thinkBudget.Get() * 1000;
+
+	if ( schedule.numFullThinks )
+	{
+		float cost = float( schedule.spent - schedule.unscheduled ) / schedule.numFullThinks;
+		schedule.averageCost = schedule.averageCost ? 0.9f * schedule.averageCost + 0.1f * cost : cost;
+	}
+
+	schedule.averageUnscheduled = 0.9f * schedule.averageUnscheduled + 0.1f * schedule.unscheduled;
+
+	if ( budget > 0 )
+	{
+		BotReportBudget( budget );
+	}
+
+	schedule.spent = 0;
+	schedule.unscheduled = 0;
+	schedule.numFullThinks = 0;
+	schedule.numDeferred = 0;
+
+	struct candidate_t
+	{
+		float urgency;
+		int   num;
+	};
+
+	std::vector<candidate_t> candidates;
+	float lodDistance = g_bot_lodDistance.Get();
+	int lodFactor = std::max( 1, g_bot_lodFactor.Get() );
+
+	for ( int i = 0; i < level.maxclients; i++ )
+	{
+		gentity_t *ent = &g_entities[ i ];
+		schedule.fullThink[ i ] = false;
+
+		if ( !ent->inuse || !ent->client->pers.isBot || !ent->botMind
+		     || G_Team( ent ) == TEAM_NONE || Entities::IsDead( ent ) )
+		{
+			continue;
+		}
+
+		int interval = g_bot_thinkInterval.Get();
+
+		if ( !BotNearPlayer( ent, lodDistance ) )
+		{
+			interval *= lodFactor;
+		}
+
+		int waited = level.time - ent->botMind->lastFullThink;
+
+		if ( budget <= 0 || waited >= interval )
+		{
+			schedule.fullThink[ i ] = true;
+			schedule.numFullThinks++;
+			continue;
+		}
+
+		candidates.push_back( { float( waited ) / std::max( interval, 1 ), i } );
+	}
+
+	int slots = candidates.size();
+
+	if ( budget > 0 && schedule.averageCost > 0 )
+	{
+		slots = std::min<int>( slots, ( budget - schedule.averageUnscheduled ) / schedule.averageCost - schedule.numFullThinks );
+		slots = std::max( slots, 0 );
+	}
+
+	std::partial_sort( candidates.begin(), candidates.begin() + slots, candidates.end(),
+		[]( const candidate_t &a, const candidate_t &b ) { return a.urgency > b.urgency; } );
+
+	for ( int i = 0; i < slots; i++ )
+	{
+		schedule.fullThink[ candidates[ i ].num ] = true;
+	}
+
+	schedule.numFullThinks += slots;
+	schedule.numDeferred = candidates.size() - slots;
+}
@@ -451,11 +451,9 @@ float BotGetHealScore( gentity_t *self )
 	return ( 1 + 5 * SkillModifier( self->botMind->skillLevel ) ) * ( 1 - percentHealth ) / sqrt( timeDist );
 }
 
-float BotGetEnemyPriority( gentity_t *self, gentity_t *ent )
+float BotGetEnemyBaseScore( const gentity_t *ent )
 {
 	float enemyScore;
-	float distanceScore;
-	distanceScore = Distance( self->s.origin, ent->s.origin );
 
 	if ( ent->client )
 	{
@@ -566,7 +564,14 @@ float BotGetEnemyPriority( gentity_t *self, gentity_t *ent )
 
 		}
 	}
-	return enemyScore * 1000 / distanceScore;
+	return enemyScore;
+}
+
+float BotGetEnemyPriority( gentity_t *self, gentity_t *ent )
+{
+	float distanceScore = Distance( self->s.origin, ent->s.origin );
+
+	return BotGetEnemyBaseScore( ent ) * 1000 / distanceScore;
 }
 
 
@@ -615,6 +620,15 @@ AINodeStatus_t BotActionEvolve( gentity_t *self, AIGenericNode_t* )
 {
 	class_t currentClass = static_cast<class_t>( self->client->ps.stats[ STAT_CLASS ] );
 
+	// trying every class is costly, the trees try to evolve every frame and
+	// fall back to fighting, so this only happens on the bot's turn
+	if ( !BotThinksFully( self ) )
+	{
+		return STATUS_FAILURE;
+	}
+
+	BotThinkBudgetScope budget;
+
 	for ( auto const& cl : classes )
 	{
 		evolveInfo_t info = BG_ClassEvolveInfoFromTo( currentClass, cl.item );
@@ -807,7 +821,6 @@ Entity Querys
 
 void BotFindClosestBuildings( gentity_t *self )
 {
-	gentity_t *testEnt;
 	botEntityAndDistance_t *ent;
 
 	// clear out building list
@@ -819,54 +832,46 @@ void BotFindClosestBuildings( gentity_t *self )
 
 	auto alliedTag = G_Team( self ) == TEAM_ALIENS ? &gentity_t::alienTag : &gentity_t::humanTag;
 
-	for ( testEnt = &g_entities[MAX_CLIENTS]; testEnt < &g_entities[level.num_entities]; testEnt++ )
+	for ( int buildable = BA_NONE + 1; buildable < BA_NUM_BUILDABLES; buildable++ )
 	{
-		float newDist;
-		// ignore entities that aren't in use
-		if ( !testEnt->inuse )
-		{
-			continue;
-		}
+		ent = &self->botMind->closestBuildings[ buildable ];
 
-		// skip non buildings
-		if ( testEnt->s.eType != entityType_t::ET_BUILDABLE )
+		for ( gentity_t *testEnt : G_BuildablesOfType( static_cast<buildable_t>( buildable ) ) )
 		{
-			continue;
-		}
+			float newDist;
 
-		// ignore dead targets
-		if ( Entities::IsDead( testEnt ) )
-		{
-			continue;
-		}
-
-		if ( G_OnSameTeam( self, testEnt ) )
-		{
-			// skip buildings that are currently building or aren't powered
-			if ( !testEnt->powered || !testEnt->spawned )
+			// ignore dead targets
+			if ( Entities::IsDead( testEnt ) )
 			{
 				continue;
 			}
-		}
-		else
-		{
-			// skip enemy buildings without tag beacons
-			// FIXME: the bot should not magically know about the death of enemy structures and hence
-			// should be able to target a beacon whose corresponding buildable is already dead.
-			if ( nullptr == testEnt->*alliedTag )
+
+			if ( G_OnSameTeam( self, testEnt ) )
 			{
-				continue;
+				// skip buildings that are currently building or aren't powered
+				if ( !testEnt->powered || !testEnt->spawned )
+				{
+					continue;
+				}
+			}
+			else
+			{
+				// skip enemy buildings without tag beacons
+				// FIXME: the bot should not magically know about the death of enemy structures and hence
+				// should be able to target a beacon whose corresponding buildable is already dead.
+				if ( nullptr == testEnt->*alliedTag )
+				{
+					continue;
+				}
 			}
-		}
-
-		newDist = Distance( self->s.origin, testEnt->s.origin );
 
-		ent = &self->botMind->closestBuildings[ testEnt->s.modelindex ];
+			newDist = Distance( self->s.origin, testEnt->s.origin );
 
-		if ( newDist < ent->distance )
-		{
-			ent->ent = testEnt;
-			ent->distance = newDist;
+			if ( newDist < ent->distance )
+			{
+				ent->ent = testEnt;
+				ent->distance = newDist;
+			}
 		}
 	}
 }
@@ -878,66 +883,108 @@ void BotFindDamagedFriendlyStructure( gentity_t *self )
 	float minDistSqr;
 	team_t team = G_Team( self );
 
-	gentity_t *target;
 	self->botMind->closestDamagedBuilding.ent = nullptr;
 	self->botMind->closestDamagedBuilding.distance = std::numeric_limits<float>::max();
 
 	minDistSqr = Square( self->botMind->closestDamagedBuilding.distance );
 
-	for ( target = &g_entities[MAX_CLIENTS]; target < &g_entities[level.num_entities]; target++ )
+	for ( int buildable = BA_NONE + 1; buildable < BA_NUM_BUILDABLES; buildable++ )
 	{
-		float distSqr;
-
-		if ( !target->inuse )
+		if ( BG_Buildable( buildable )->team != team )
 		{
 			continue;
 		}
 
-		if ( target->s.eType != entityType_t::ET_BUILDABLE )
+		for ( gentity_t *target : G_BuildablesOfType( static_cast<buildable_t>( buildable ) ) )
 		{
-			continue;
-		}
+			float distSqr;
 
-		if ( target->buildableTeam != self->client->pers.team )
-		{
-			continue;
-		}
+			if ( team == TEAM_HUMANS && Entities::HasFullHealth(target) )
+			{
+				continue;
+			}
 
-		if ( team == TEAM_HUMANS && Entities::HasFullHealth(target) )
-		{
-			continue;
-		}
+			if ( team == TEAM_ALIENS && ( !G_IsOnFire( target ) || target->s.origin2[ 2 ] < MIN_WALK_NORMAL ) )
+			{
+				continue;
+			}
 
-		if ( team == TEAM_ALIENS && ( !G_IsOnFire( target ) || target->s.origin2[ 2 ] < MIN_WALK_NORMAL ) )
-		{
-			continue;
-		}
+			if ( Entities::IsDead( target ) )
+			{
+				continue;
+			}
 
-		if ( Entities::IsDead( target ) )
-		{
-			continue;
-		}
+			if ( !target->spawned || !target->powered )
+			{
+				continue;
+			}
 
-		if ( !target->spawned || !target->powered )
-		{
-			continue;
+			distSqr = DistanceSquared( self->s.origin, target->s.origin );
+			if ( distSqr < minDistSqr )
+			{
+				self->botMind->closestDamagedBuilding.ent = target;
+				self->botMind->closestDamagedBuilding.distance = sqrtf( distSqr );
+				minDistSqr = distSqr;
+			}
 		}
+	}
+}
 
-		distSqr = DistanceSquared( self->s.origin, target->s.origin );
-		if ( distSqr < minDistSqr )
-		{
-			self->botMind->closestDamagedBuilding.ent = target;
-			self->botMind->closestDamagedBuilding.distance = sqrtf( distSqr );
-			minDistSqr = distSqr;
-		}
+static void BotRefreshBuilding( gentity_t *self, botEntityAndDistance_t &cache, int buildable )
+{
+	const gentity_t *ent = cache.ent;
+
+	if ( !ent )
+	{
+		return;
 	}
+
+	// the slot may have been freed, or reused by something else
+	if ( !ent->inuse || ent->s.eType != entityType_t::ET_BUILDABLE
+	     || ( buildable != BA_NONE && ent->s.modelindex != buildable ) || Entities::IsDead( ent ) )
+	{
+		cache.ent = nullptr;
+		cache.distance = std::numeric_limits<float>::max();
+		return;
+	}
+
+	cache.distance = Distance( self->s.origin, ent->s.origin );
 }
 
-static bool BotEntityIsVisible( const gentity_t *self, gentity_t *target, int mask )
+/*
+=======================
+BotRefreshCaches
+
+Cheap update of what the searches of the last full think found, for the frames
+in which the bot does not search again, see BotThinksFully
+=======================
+*/
+void BotRefreshCaches( gentity_t *self )
 {
-	botTarget_t bt;
-	bt = target;
-	return BotTargetIsVisible( self, bt, mask );
+	botMemory_t *mind = self->botMind;
+
+	if ( mind->bestEnemy.ent && !BotEntityIsValidEnemyTarget( self, mind->bestEnemy.ent ) )
+	{
+		mind->bestEnemy.ent = nullptr;
+	}
+
+	mind->bestEnemy.distance = mind->bestEnemy.ent
+		? Distance( self->s.origin, mind->bestEnemy.ent->s.origin )
+		: std::numeric_limits<float>::max();
+
+	for ( int buildable = BA_NONE + 1; buildable < BA_NUM_BUILDABLES; buildable++ )
+	{
+		BotRefreshBuilding( self, mind->closestBuildings[ buildable ], buildable );
+	}
+
+	BotRefreshBuilding( self, mind->closestDamagedBuilding, BA_NONE );
+
+	if ( mind->closestDamagedBuilding.ent && G_Team( self ) == TEAM_HUMANS
+	     && Entities::HasFullHealth( mind->closestDamagedBuilding.ent ) )
+	{
+		mind->closestDamagedBuilding.ent = nullptr;
+		mind->closestDamagedBuilding.distance = std::numeric_limits<float>::max();
+	}
 }
 
 static float BotAimAngle( gentity_t *self, const glm::vec3 &pos )
@@ -957,49 +1004,48 @@ gentity_t* BotFindBestEnemy( gentity_t *self )
 	float bestInvisibleEnemyScore = 0.0f;
 	gentity_t *bestVisibleEnemy = nullptr;
 	gentity_t *bestInvisibleEnemy = nullptr;
-	gentity_t *target;
 	team_t    team = G_Team( self );
 	bool  hasRadar = ( team == TEAM_ALIENS ) ||
 	                     ( team == TEAM_HUMANS && BG_InventoryContainsUpgrade( UP_RADAR, self->client->ps.stats ) );
 
-	for ( target = g_entities; target < &g_entities[level.num_entities]; target++ )
+	for ( const botPerceivedEntity_t &target : BotPerceivedEnemies( self ) )
 	{
 		float newScore;
 
-		if ( !BotEntityIsValidEnemyTarget( self, target ) )
+		if ( !BotEntityIsValidEnemyTarget( self, target.ent ) )
 		{
 			continue;
 		}
 
-		if ( DistanceSquared( self->s.origin, target->s.origin ) > Square( g_bot_aliensenseRange.Get() ) )
+		float distSqr = glm::distance2( VEC2GLM( self->s.origin ), target.origin );
+		if ( distSqr > Square( g_bot_aliensenseRange.Get() ) )
 		{
 			continue;
 		}
 
-		glm::vec3 vorigin = VEC2GLM( target->s.origin );
-		if ( target->s.eType == entityType_t::ET_PLAYER && self->client->pers.team == TEAM_HUMANS
-		    && BotAimAngle( self, vorigin ) > g_bot_fov.Get() / 2 )
+		if ( target.eType == entityType_t::ET_PLAYER && self->client->pers.team == TEAM_HUMANS
+		    && BotAimAngle( self, target.origin ) > g_bot_fov.Get() / 2 )
 		{
 			continue;
 		}
 
-		if ( target == self->botMind->goal.getTargetedEntity() )
+		if ( target.ent == self->botMind->goal.getTargetedEntity() )
 		{
 			continue;
 		}
 
-		newScore = BotGetEnemyPriority( self, target );
+		newScore = target.score * 1000 / sqrtf( distSqr );
 
-		if ( newScore > bestVisibleEnemyScore && BotEntityIsVisible( self, target, MASK_OPAQUE ) )
+		if ( newScore > bestVisibleEnemyScore && BotPerceivedIsVisible( self, target ) )
 		{
 			//store the new score and the index of the entity
 			bestVisibleEnemyScore = newScore;
-			bestVisibleEnemy = target;
+			bestVisibleEnemy = target.ent;
 		}
 		else if ( newScore > bestInvisibleEnemyScore && hasRadar )
 		{
 			bestInvisibleEnemyScore = newScore;
-			bestInvisibleEnemy = target;
+			bestInvisibleEnemy = target.ent;
 		}
 	}
 	if ( bestVisibleEnemy || !hasRadar )
@@ -1016,27 +1062,21 @@ gentity_t* BotFindClosestEnemy( gentity_t *self )
 {
 	gentity_t* closestEnemy = nullptr;
 	float minDistance = Square( g_bot_aliensenseRange.Get() );
-	gentity_t *target;
 
-	for ( target = g_entities; target < &g_entities[level.num_entities]; target++ )
+	for ( const botPerceivedEntity_t &target : BotPerceivedEnemies( self ) )
 	{
 		float newDistance;
-		//ignore entities that arnt in use
-		if ( !target->inuse )
-		{
-			continue;
-		}
 
-		if ( !BotEntityIsValidEnemyTarget( self, target ) )
+		if ( !BotEntityIsValidEnemyTarget( self, target.ent ) )
 		{
 			continue;
 		}
 
-		newDistance = DistanceSquared( self->s.origin, target->s.origin );
+		newDistance = glm::distance2( VEC2GLM( self->s.origin ), target.origin );
 		if ( newDistance <= minDistance )
 		{
 			minDistance = newDistance;
-			closestEnemy = target;
+			closestEnemy = target.ent;
 		}
 	}
 	return closestEnemy;
@@ -1249,6 +1289,9 @@ bool BotChangeGoal( gentity_t *self, botTarget_t target )
 		return false;
 	}
 
+	// the behavior tree needs the route now, even out of the bot's turn
+	BotThinkBudgetScope budget( BotThinksFully( self ) );
+
 	if ( !FindRouteToTarget( self, target, false ) )
 	{
 		// TODO: allow adv marauder and adv goon to pick offmesh targets,
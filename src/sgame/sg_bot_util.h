@@ -31,6 +31,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "sg_bot_local.h"
 
 #include <glm/vec3.hpp>
+#include <chrono>
 
 bool PlayersBehindBotInSpawnQueue( gentity_t *self );
 int      BotGetDefaultSkill();
@@ -46,6 +47,7 @@ int        FindBots( int *botEntityNumbers, int maxBots, team_t team );
 gentity_t* BotFindClosestEnemy( gentity_t *self );
 gentity_t* BotFindBestEnemy( gentity_t *self );
 void       BotFindClosestBuildings( gentity_t *self );
+void       BotRefreshCaches( gentity_t *self );
 bool   BotTeamateHasWeapon( gentity_t *self, int weapon );
 void       BotSearchForEnemy( gentity_t *self );
 void       BotPain( gentity_t *self, gentity_t *attacker, int damage );
@@ -57,6 +59,26 @@ void  BotAimAtEnemy( gentity_t *self );
 void  BotSlowAim( gentity_t *self, glm::vec3& target, float slow );
 void  BotAimAtLocation( gentity_t *self, const glm::vec3 &target );
 
+// perception
+const std::vector<botPerceivedEntity_t> &BotPerceivedEnemies( const gentity_t *self );
+bool BotPerceivedIsVisible( const gentity_t *self, const botPerceivedEntity_t &target );
+
+// scheduling
+bool BotThinksFully( const gentity_t *self );
+
+// counts the time spent in its lifetime against the bots' think budget,
+// unscheduled for the work done out of the bot's turn
+class BotThinkBudgetScope
+{
+public:
+	explicit BotThinkBudgetScope( bool scheduled = true );
+	~BotThinkBudgetScope();
+
+private:
+	std::chrono::steady_clock::time_point start;
+	bool scheduled;
+};
+
 // targets
 bool BotEntityIsValidTarget( const gentity_t *ent );
 bool BotEntityIsValidEnemyTarget( const gentity_t *self, const gentity_t *enemy );
@@ -71,6 +93,7 @@ botTarget_t BotGetRushTarget( const gentity_t *self );
 float    BotGetHealScore( gentity_t *self );
 float    BotGetResupplyScore( gentity_t *ent );
 float    BotGetBaseRushScore( gentity_t *ent );
+float    BotGetEnemyBaseScore( const gentity_t *ent );
 float    BotGetEnemyPriority( gentity_t *self, gentity_t *ent );
 
 // goal changing
@@ -51,46 +51,65 @@ bool G_IsWarnableMOD(meansOfDeath_t mod) {
 	}
 }
 
-static gentity_t *FindBuildable(buildable_t buildable) {
-	gentity_t* found = nullptr;
+// Buildables of each type, maintained by BuildableComponent. As every type
+// belongs to a single team this also sorts them by team. There are only a few
+// dozen buildables of a type at most, so queries just walk the list and check
+// the state (power, health, tags) they care about.
+static std::vector<gentity_t*> buildableIndex[BA_NUM_BUILDABLES];
+
+void G_IndexBuildable(gentity_t *ent) {
+	buildableIndex[ent->s.modelindex].push_back(ent);
+}
 
-	ForEntities<BuildableComponent>([&](Entity& entity, BuildableComponent&) {
-		if (entity.oldEnt->s.modelindex == buildable) {
-			found = entity.oldEnt;
-		}
-	});
+void G_UnindexBuildable(gentity_t *ent) {
+	std::vector<gentity_t*> &list = buildableIndex[ent->s.modelindex];
+	auto it = std::find(list.begin(), list.end(), ent);
+
+	if (it != list.end()) {
+		*it = list.back();
+		list.pop_back();
+	}
+}
+
+/**
+ * @return The buildables of a type, alive or not, in no particular order.
+ */
+const std::vector<gentity_t*> &G_BuildablesOfType(buildable_t buildable) {
+	return buildableIndex[buildable];
+}
+
+static gentity_t *FindBuildable(buildable_t buildable) {
+	const std::vector<gentity_t*> &list = G_BuildablesOfType(buildable);
 
-	return found;
+	return list.empty() ? nullptr : list.back();
 }
 
-template<typename Component>
-static gentity_t *LookUpMainBuildable(bool requireActive)
+static gentity_t *LookUpMainBuildable(buildable_t buildable, bool requireActive)
 {
-	gentity_t *answer = nullptr;
-	ForEntities<Component>([&](Entity& entity, Component&) {
+	for (gentity_t *ent : G_BuildablesOfType(buildable)) {
 		if (!requireActive ||
-		    entity.Get<BuildableComponent>()->GetState() == BuildableComponent::CONSTRUCTED)
+		    ent->entity->Get<BuildableComponent>()->GetState() == BuildableComponent::CONSTRUCTED)
 		{
-			answer = entity.oldEnt;
+			return ent;
 		}
-	});
-	return answer;
+	}
+	return nullptr;
 }
 
 gentity_t *G_Overmind() {
-	return LookUpMainBuildable<OvermindComponent>(false);
+	return LookUpMainBuildable(BA_A_OVERMIND, false);
 }
 
 gentity_t *G_ActiveOvermind() {
-	return LookUpMainBuildable<OvermindComponent>(true);
+	return LookUpMainBuildable(BA_A_OVERMIND, true);
 }
 
 gentity_t *G_Reactor() {
-	return LookUpMainBuildable<ReactorComponent>(false);
+	return LookUpMainBuildable(BA_H_REACTOR, false);
 }
 
 gentity_t *G_ActiveReactor() {
-	return LookUpMainBuildable<ReactorComponent>(true);
+	return LookUpMainBuildable(BA_H_REACTOR, true);
 }
 
 gentity_t *G_MainBuildable(team_t team) {
@@ -137,7 +156,7 @@ bool G_InsideBase(gentity_t *self) {
 		return false;
 	}
 
-	return trap_InPVSIgnorePortals(self->s.origin, mainBuilding->s.origin);
+	return G_EntitiesInPVSIgnorePortals(self, mainBuilding);
 }
 
 bool G_DretchCanDamageEntity( const gentity_t *ent )
@@ -292,20 +311,17 @@ static void ABarricade_Touch( gentity_t *self, gentity_t *other )
 
 static void ABooster_Think( gentity_t *self )
 {
-	gentity_t *ent;
 	bool  playHealingEffect = false;
 
 	self->nextthink = level.time + BOOST_REPEAT_ANIM / 4;
 
 	// check if there is a closeby alien that used this booster for healing recently
-	for ( ent = nullptr; ( ent = G_IterateEntitiesWithinRadius( ent, VEC2GLM( self->s.origin ), REGEN_BOOSTER_RANGE ) ); )
-	{
+	G_ForEntitiesInRadius( VEC2GLM( self->s.origin ), REGEN_BOOSTER_RANGE, {}, [&]( gentity_t *ent ) {
 		if ( ent->boosterUsed == self && ent->boosterTime == level.previousTime )
 		{
 			playHealingEffect = true;
-			break;
 		}
-	}
+	} );
 
 	if ( playHealingEffect )
 	{
@@ -552,17 +568,22 @@ void G_BuildableTouchTriggers( gentity_t *ent )
  */
 bool G_BuildableInRange( vec3_t origin, float radius, buildable_t buildable )
 {
-	gentity_t *neighbor = nullptr;
+	float radiusSquared = Square( radius );
 
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, VEC2GLM( origin ), radius ) ) )
+	for ( gentity_t *neighbor : G_BuildablesOfType( buildable ) )
 	{
-		if ( neighbor->s.eType != entityType_t::ET_BUILDABLE || !neighbor->spawned || Entities::IsDead( neighbor ) ||
+		if ( !neighbor->r.linked || !neighbor->spawned || Entities::IsDead( neighbor ) ||
 		     ( neighbor->buildableTeam == TEAM_HUMANS && !neighbor->powered ) )
 		{
 			continue;
 		}
 
-		if ( neighbor->s.modelindex == buildable )
+		// same test as G_ForEntitiesInRadius
+		vec3_t center;
+		VectorAdd( neighbor->r.mins, neighbor->r.maxs, center );
+		VectorMA( neighbor->r.currentOrigin, 0.5f, center, center );
+
+		if ( DistanceSquared( center, origin ) <= radiusSquared )
 		{
 			return true;
 		}
@@ -1518,7 +1539,7 @@ static gentity_t *SpawnBuildable( gentity_t *builder, buildable_t buildable, con
 
 	built->s.eType = entityType_t::ET_BUILDABLE;
 	built->killedBy = ENTITYNUM_NONE;
-	built->classname = BG_strdup( attr->entityName );
+	G_SetClassname( built, attr->entityName );
 	built->s.modelindex = buildable;
 	built->s.modelindex2 = attr->team;
 	built->buildableTeam = (team_t) built->s.modelindex2;
@@ -38,15 +38,52 @@ Maryland 20850 USA.
 #include "sg_local.h"
 #include "sg_cm_world.h"
 
-struct worldSector_t;
+
 struct worldEntity_t
 {
-	worldSector_t *worldSector;
-	worldEntity_t *nextEntityInWorldSector;
+	int    leaf; // index of the entity's leaf in the world tree, -1 if not in the tree
+
+	// BSP leaf containing s.origin, valid while it equals pvsOrigin
+	vec3_t pvsOrigin;
+	int    pvsLeafnum; // -1 if not computed yet
 };
 
 worldEntity_t wentities[ MAX_GENTITIES ];
 
+// copy of r.absmin / r.absmax of the linked entities, packed so that the
+// overlap tests read one cache line per entity instead of its gentity_t
+struct worldBounds_t
+{
+	vec3_t absmin;
+	vec3_t absmax;
+};
+
+static worldBounds_t sv_worldBounds[ MAX_GENTITIES ];
+
+// rewound position of a client while unlagged is on, see G_CM_SetBoundsOverride
+struct boundsOverride_t
+{
+	vec3_t origin;
+	vec3_t mins;
+	vec3_t maxs;
+
+	// the real bounds, sv_worldBounds holds the rewound ones meanwhile
+	vec3_t absmin;
+	vec3_t absmax;
+};
+
+static boundsOverride_t sv_boundsOverrides[ MAX_CLIENTS ];
+static bool             sv_overridden[ MAX_CLIENTS ];
+static int              sv_overriddenList[ MAX_CLIENTS ];
+static int              sv_numOverridden;
+
+static const boundsOverride_t *G_CM_BoundsOverride( const gentity_t *ent )
+{
+	int num = ent->num();
+
+	return num < MAX_CLIENTS && sv_overridden[ num ] ? &sv_boundsOverrides[ num ] : nullptr;
+}
+
 static worldEntity_t *G_CM_WorldEntityForGentity( gentity_t *gEnt )
 {
 	if ( !gEnt || gEnt->num() < 0 || gEnt->num() >= MAX_GENTITIES )
@@ -57,14 +94,6 @@ static worldEntity_t *G_CM_WorldEntityForGentity( gentity_t *gEnt )
 	return &wentities[ gEnt->num() ];
 }
 
-static gentity_t *G_CM_GEntityForWorldEntity( worldEntity_t *ent )
-{
-	int num;
-
-	num = ent - wentities;
-	return &g_entities[ num ];
-}
-
 /*
 =================
 G_CM_SetBrushModel
@@ -98,56 +127,181 @@ void G_CM_SetBrushModel( gentity_t *ent, const char *name )
 	ent->r.contents = -1; // we don't know exactly what is in the brushes
 }
 
+static Cvar::Cvar<bool> g_analyticBoxClip( "g_analyticBoxClip", "clip traces against entity boxes without the generic BSP code", Cvar::NONE, true );
+
 /*
 ================
 G_CM_ClipHandleForEntity
 
 Returns a headnode that can be used for testing or clipping to a
 given entity.  If the entity is a bsp model, the headnode will
-be returned, otherwise a custom box tree will be constructed.
+be returned, otherwise a custom box tree will be constructed
+from mins / maxs.
 ================
 */
-static clipHandle_t G_CM_ClipHandleForEntity( const gentity_t *ent )
+static clipHandle_t G_CM_ClipHandleForEntity( const gentity_t *ent, const vec3_t mins, const vec3_t maxs )
 {
+	// the temporary box is shared by all entities, but many entities of
+	// the same class are checked in a row, so keep it while the size matches
+	static clipHandle_t tempBox;
+	static vec3_t       tempBoxMins, tempBoxMaxs;
+
 	if ( ent->r.bmodel )
 	{
 		// explicit hulls in the BSP model
 		return CM_InlineModel( ent->s.modelindex );
 	}
 
-	// create a temp tree/capsule from bounding box sizes
-	return CM_TempBoxModel( ent->r.mins, ent->r.maxs, /*capsule = */ ent->r.svFlags & SVF_CAPSULE );
+	if ( ent->r.svFlags & SVF_CAPSULE )
+	{
+		// clipping against capsules rebuilds the temporary box internally
+		tempBox = 0;
+		return CM_TempBoxModel( mins, maxs, /*capsule = */ true );
+	}
+
+	if ( tempBox && VectorCompare( mins, tempBoxMins ) && VectorCompare( maxs, tempBoxMaxs ) )
+	{
+		return tempBox;
+	}
+
+	// create a temp tree from bounding box sizes
+	tempBox = CM_TempBoxModel( mins, maxs, /*capsule = */ false );
+	VectorCopy( mins, tempBoxMins );
+	VectorCopy( maxs, tempBoxMaxs );
+
+	return tempBox;
+}
+
+/*
+================
+G_CM_ClipToEntity
+
+Traces the move against a single entity. Plain boxes are swept
+analytically, everything else goes through the collision model.
+================
+*/
+static void G_CM_ClipToEntity( trace_t *trace, const gentity_t *touch, const vec3_t start, const vec3_t end,
+                               const vec3_t mins, const vec3_t maxs, int contentmask, traceType_t type )
+{
+	const float *origin = touch->r.currentOrigin;
+	const float *touchMins = touch->r.mins;
+	const float *touchMaxs = touch->r.maxs;
+
+	if ( const boundsOverride_t *rewound = G_CM_BoundsOverride( touch ) )
+	{
+		origin = rewound->origin;
+		touchMins = rewound->mins;
+		touchMaxs = rewound->maxs;
+	}
+
+	if ( !touch->r.bmodel && !( touch->r.svFlags & SVF_CAPSULE ) && type == traceType_t::TT_AABB
+	     && g_analyticBoxClip.Get() )
+	{
+		BG_BoxTraceAgainstBox( trace, start, end, mins, maxs, touchMins, touchMaxs,
+		                       origin, contentmask, 0 );
+		return;
+	}
+
+	// might intersect, so do an exact clip
+	clipHandle_t clipHandle = G_CM_ClipHandleForEntity( touch, touchMins, touchMaxs );
+
+	const float *angles = touch->r.currentAngles;
+
+	if ( !touch->r.bmodel )
+	{
+		angles = vec3_origin; // boxes don't rotate
+	}
+
+	CM_TransformedBoxTrace( trace, start, end, mins, maxs, clipHandle,
+	                        contentmask, 0, origin, angles, type );
+}
+
+/*
+===============================================================================
+
+PVS CHECKS
+
+The BSP leaf of a point never changes, so the leafs of the points queried
+recently are kept in a small direct mapped cache, and the leaf of the
+origin of each entity is kept until the entity moves.
+
+===============================================================================
+*/
+
+struct leafCacheEntry_t
+{
+	vec3_t point;
+	int    leafnum; // -1 for empty entries
+};
+
+static leafCacheEntry_t sv_leafCache[ 256 ];
+
+static void G_CM_ClearLeafCache()
+{
+	for ( leafCacheEntry_t &entry : sv_leafCache )
+	{
+		entry.leafnum = -1;
+	}
+
+	for ( worldEntity_t &went : wentities )
+	{
+		went.pvsLeafnum = -1;
+	}
+}
+
+static int G_CM_CachedPointLeafnum( const vec3_t p )
+{
+	uint32_t bits[ 3 ];
+	memcpy( bits, p, sizeof( bits ) );
+
+	uint32_t hash = bits[ 0 ] * 73856093u ^ bits[ 1 ] * 19349663u ^ bits[ 2 ] * 83492791u;
+	leafCacheEntry_t &entry = sv_leafCache[ ( hash ^ ( hash >> 16 ) ) % ARRAY_LEN( sv_leafCache ) ];
+
+	if ( entry.leafnum == -1 || !VectorCompare( entry.point, p ) )
+	{
+		VectorCopy( p, entry.point );
+		entry.leafnum = CM_PointLeafnum( p );
+	}
+
+	return entry.leafnum;
+}
+
+static int G_CM_EntityLeafnum( gentity_t *ent )
+{
+	worldEntity_t *went = G_CM_WorldEntityForGentity( ent );
+
+	if ( went->pvsLeafnum == -1 || !VectorCompare( went->pvsOrigin, ent->s.origin ) )
+	{
+		VectorCopy( ent->s.origin, went->pvsOrigin );
+		went->pvsLeafnum = G_CM_CachedPointLeafnum( ent->s.origin );
+	}
+
+	return went->pvsLeafnum;
 }
 
 /*
 =================
-G_CM_inPVS
+G_CM_LeafsInPVS
 
-Also checks portalareas so that doors block sight
+Optionally checks portalareas so that doors block sight
 =================
 */
-bool G_CM_inPVS( const vec3_t p1, const vec3_t p2 )
+static bool G_CM_LeafsInPVS( int leafnum1, int leafnum2, bool checkPortals )
 {
-	int  leafnum;
 	int  cluster;
-	int  area1, area2;
 	byte *mask;
 
-	leafnum = CM_PointLeafnum( p1 );
-	cluster = CM_LeafCluster( leafnum );
-	area1 = CM_LeafArea( leafnum );
+	cluster = CM_LeafCluster( leafnum1 );
 	mask = CM_ClusterPVS( cluster );
 
-	leafnum = CM_PointLeafnum( p2 );
-	cluster = CM_LeafCluster( leafnum );
-	area2 = CM_LeafArea( leafnum );
+	cluster = CM_LeafCluster( leafnum2 );
 
 	if ( mask && ( !( mask[ cluster >> 3 ] & ( 1 << ( cluster & 7 ) ) ) ) )
 	{
 		return false;
 	}
 
-	if ( !CM_AreasConnected( area1, area2 ) )
+	if ( checkPortals && !CM_AreasConnected( CM_LeafArea( leafnum1 ), CM_LeafArea( leafnum2 ) ) )
 	{
 		return false; // a door blocks sight
 	}
@@ -155,6 +309,18 @@ bool G_CM_inPVS( const vec3_t p1, const vec3_t p2 )
 	return true;
 }
 
+/*
+=================
+G_CM_inPVS
+
+Also checks portalareas so that doors block sight
+=================
+*/
+bool G_CM_inPVS( const vec3_t p1, const vec3_t p2 )
+{
+	return G_CM_LeafsInPVS( G_CM_CachedPointLeafnum( p1 ), G_CM_CachedPointLeafnum( p2 ), true );
+}
+
 /*
 =================
 G_CM_inPVSIgnorePortals
@@ -164,26 +330,31 @@ Does NOT check portalareas
 */
 bool G_CM_inPVSIgnorePortals( const vec3_t p1, const vec3_t p2 )
 {
-	int  leafnum;
-	int  cluster;
-//	int             area1, area2; //unused
-	byte *mask;
+	return G_CM_LeafsInPVS( G_CM_CachedPointLeafnum( p1 ), G_CM_CachedPointLeafnum( p2 ), false );
+}
 
-	leafnum = CM_PointLeafnum( p1 );
-	cluster = CM_LeafCluster( leafnum );
-//	area1 = CM_LeafArea(leafnum); //Doesn't modify anything.
+/*
+=================
+G_EntitiesInPVS
 
-	mask = CM_ClusterPVS( cluster );
-	leafnum = CM_PointLeafnum( p2 );
-	cluster = CM_LeafCluster( leafnum );
-//	area2 = CM_LeafArea(leafnum); //Doesn't modify anything.
+Same as G_CM_inPVS between the origins (s.origin) of the entities
+=================
+*/
+bool G_EntitiesInPVS( gentity_t *a, gentity_t *b )
+{
+	return G_CM_LeafsInPVS( G_CM_EntityLeafnum( a ), G_CM_EntityLeafnum( b ), true );
+}
 
-	if ( mask && ( !( mask[ cluster >> 3 ] & ( 1 << ( cluster & 7 ) ) ) ) )
-	{
-		return false;
-	}
+/*
+=================
+G_EntitiesInPVSIgnorePortals
 
-	return true;
+Same as G_CM_inPVSIgnorePortals between the origins (s.origin) of the entities
+=================
+*/
+bool G_EntitiesInPVSIgnorePortals( gentity_t *a, gentity_t *b )
+{
+	return G_CM_LeafsInPVS( G_CM_EntityLeafnum( a ), G_CM_EntityLeafnum( b ), false );
 }
 
 /*
@@ -216,7 +387,15 @@ bool G_CM_EntityContact( const vec3_t mins, const vec3_t maxs, const gentity_t *
 	origin = gEnt->r.currentOrigin;
 	angles = gEnt->r.currentAngles;
 
-	ch = G_CM_ClipHandleForEntity( gEnt );
+	const boundsOverride_t *rewound = G_CM_BoundsOverride( gEnt );
+
+	if ( rewound )
+	{
+		origin = rewound->origin;
+	}
+
+	ch = rewound ? G_CM_ClipHandleForEntity( gEnt, rewound->mins, rewound->maxs )
+	             : G_CM_ClipHandleForEntity( gEnt, gEnt->r.mins, gEnt->r.maxs );
 	CM_TransformedBoxTrace( &trace, vec3_origin, vec3_origin, mins, maxs, ch, MASK_ALL, 0, origin,
 	                        angles, type );
 
@@ -228,101 +407,346 @@ bool G_CM_EntityContact( const vec3_t mins, const vec3_t maxs, const gentity_t *
 ENTITY CHECKING
 
 To avoid linearly searching through lists of entities during environment testing,
-the world is carved up with an evenly spaced, axially aligned bsp tree.  Entities
-are kept in chains either at the final leafs, or at the first node that splits
-them, which prevents having to deal with multiple fragments of a single entity.
+linked entities are kept in a dynamic bounding volume hierarchy. Every entity is a
+leaf holding a slightly enlarged ("fat") copy of its absolute bounds, and every
+interior node encloses both of its children. The tree is kept balanced with tree
+rotations as leaves are inserted and removed.
+
+An entity that moves, but stays within its fat bounds, does not need to touch the
+tree at all; only once it leaves them is it removed and reinserted.
 
 ===============================================================================
 */
 
-struct worldSector_t
+struct worldNode_t
 {
-	int                  axis; // -1 = leaf node
-	float                dist;
-	worldSector_t        *children[ 2 ];
-
-	worldEntity_t        *entities;
+	vec3_t absmin, absmax; // fat bounds for leaves, union of the children otherwise
+	int    parent; // next free node when on the free list
+	int    children[ 2 ]; // -1 for leaves
+	int    height; // 0 for leaves, -1 for free nodes
+	int    entityNum; // leaves only
 };
 
-#define AREA_DEPTH 4
-#define AREA_NODES 64
+static std::vector<worldNode_t> sv_worldNodes;
+static int                      sv_worldRoot;
+static int                      sv_worldFreeNode;
+static float                    sv_worldMargin;
+
+// counters reported (and reset) by G_CM_SectorList_f
+static struct
+{
+	int queries;
+	int nodesVisited;
+	int candidates;
+	int results;
+	int links;
+	int linksInPlace; // still within the fat bounds of their leaf
+	int reinsertions; // moved out of them, removed from the tree and inserted again
+} sv_worldStats;
+
+static bool G_CM_NodeIsLeaf( const worldNode_t &node )
+{
+	return node.children[ 0 ] == -1;
+}
 
-worldSector_t sv_worldSectors[ AREA_NODES ];
-int           sv_numworldSectors;
+static void G_CM_BoundsUnion( const worldNode_t &a, const worldNode_t &b, vec3_t mins, vec3_t maxs )
+{
+	for ( int i = 0; i < 3; i++ )
+	{
+		mins[ i ] = std::min( a.absmin[ i ], b.absmin[ i ] );
+		maxs[ i ] = std::max( a.absmax[ i ], b.absmax[ i ] );
+	}
+}
+
+// half of the surface area, used as the insertion cost
+static float G_CM_BoundsCost( const vec3_t mins, const vec3_t maxs )
+{
+	float dx = maxs[ 0 ] - mins[ 0 ];
+	float dy = maxs[ 1 ] - mins[ 1 ];
+	float dz = maxs[ 2 ] - mins[ 2 ];
+
+	return dx * dy + dy * dz + dz * dx;
+}
+
+static void G_CM_FitNode( int index )
+{
+	worldNode_t &node = sv_worldNodes[ index ];
+	const worldNode_t &child0 = sv_worldNodes[ node.children[ 0 ] ];
+	const worldNode_t &child1 = sv_worldNodes[ node.children[ 1 ] ];
+
+	G_CM_BoundsUnion( child0, child1, node.absmin, node.absmax );
+	node.height = 1 + std::max( child0.height, child1.height );
+}
+
+static int G_CM_AllocNode()
+{
+	if ( sv_worldFreeNode == -1 )
+	{
+		sv_worldNodes.emplace_back();
+		sv_worldFreeNode = sv_worldNodes.size() - 1;
+		sv_worldNodes.back().parent = -1;
+	}
+
+	int index = sv_worldFreeNode;
+	worldNode_t &node = sv_worldNodes[ index ];
+
+	sv_worldFreeNode = node.parent;
+	node.parent = -1;
+	node.children[ 0 ] = node.children[ 1 ] = -1;
+	node.height = 0;
+	node.entityNum = ENTITYNUM_NONE;
+
+	return index;
+}
+
+static void G_CM_FreeNode( int index )
+{
+	worldNode_t &node = sv_worldNodes[ index ];
+
+	node.parent = sv_worldFreeNode;
+	node.height = -1;
+	sv_worldFreeNode = index;
+}
+
+static void G_CM_ReplaceChild( int parent, int oldChild, int newChild )
+{
+	if ( parent == -1 )
+	{
+		sv_worldRoot = newChild;
+		return;
+	}
+
+	worldNode_t &node = sv_worldNodes[ parent ];
+
+	if ( node.children[ 0 ] == oldChild )
+	{
+		node.children[ 0 ] = newChild;
+	}
+	else
+	{
+		node.children[ 1 ] = newChild;
+	}
+}
 
 /*
 ===============
-G_CM_SectorList_f
+G_CM_BalanceNode
+
+Performs a left or right rotation if the node is unbalanced.
+Returns the index of the node now at the position of the given one.
 ===============
 */
-void G_CM_SectorList_f()
+static int G_CM_BalanceNode( int iA )
 {
-	int           i, c;
-	worldSector_t *sec;
-	worldEntity_t    *ent;
+	worldNode_t &A = sv_worldNodes[ iA ];
 
-	for ( i = 0; i < AREA_NODES; i++ )
+	if ( G_CM_NodeIsLeaf( A ) || A.height < 2 )
 	{
-		sec = &sv_worldSectors[ i ];
+		return iA;
+	}
+
+	// the pair of children to rotate up depends on which side is higher
+	for ( int side = 0; side < 2; side++ )
+	{
+		int iB = A.children[ side ];
+		int iC = A.children[ !side ];
+		worldNode_t &B = sv_worldNodes[ iB ];
+		worldNode_t &C = sv_worldNodes[ iC ];
+
+		if ( C.height - B.height <= 1 )
+		{
+			continue;
+		}
+
+		// rotate C up
+		int iF = C.children[ 0 ];
+		int iG = C.children[ 1 ];
 
-		c = 0;
+		C.children[ 0 ] = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+		G_CM_ReplaceChild( C.parent, iA, iC );
 
-		for ( ent = sec->entities; ent; ent = ent->nextEntityInWorldSector )
+		// the higher grandchild stays below C, the other one moves to A
+		if ( sv_worldNodes[ iF ].height > sv_worldNodes[ iG ].height )
 		{
-			c++;
+			std::swap( iF, iG );
 		}
 
-		Log::Notice( "sector %i: %i entities", i, c );
+		C.children[ 1 ] = iG;
+		A.children[ !side ] = iF;
+		sv_worldNodes[ iF ].parent = iA;
+
+		G_CM_FitNode( iA );
+		G_CM_FitNode( iC );
+
+		return iC;
 	}
+
+	return iA;
 }
 
-/*
-===============
-G_CM_CreateworldSector
+static void G_CM_RefitAncestors( int index )
+{
+	while ( index != -1 )
+	{
+		index = G_CM_BalanceNode( index );
+		G_CM_FitNode( index );
+		index = sv_worldNodes[ index ].parent;
+	}
+}
 
-Builds a uniformly subdivided tree for the given world size
-===============
-*/
-static worldSector_t *G_CM_CreateworldSector( int depth, vec3_t mins,
-		vec3_t maxs )
+static void G_CM_InsertLeaf( int leaf )
 {
-	worldSector_t *anode;
-	vec3_t        size;
-	vec3_t        mins1, maxs1, mins2, maxs2;
+	if ( sv_worldRoot == -1 )
+	{
+		sv_worldRoot = leaf;
+		sv_worldNodes[ leaf ].parent = -1;
+		return;
+	}
 
-	anode = &sv_worldSectors[ sv_numworldSectors ];
-	sv_numworldSectors++;
+	// find the best sibling by descending towards the cheapest enlargement
+	int    index = sv_worldRoot;
+	vec3_t mins, maxs;
 
-	if ( depth == AREA_DEPTH )
+	while ( !G_CM_NodeIsLeaf( sv_worldNodes[ index ] ) )
 	{
-		anode->axis = -1;
-		anode->children[ 0 ] = anode->children[ 1 ] = nullptr;
-		return anode;
+		const worldNode_t &node = sv_worldNodes[ index ];
+		const worldNode_t &leafNode = sv_worldNodes[ leaf ];
+
+		float area = G_CM_BoundsCost( node.absmin, node.absmax );
+		G_CM_BoundsUnion( node, leafNode, mins, maxs );
+		float combinedArea = G_CM_BoundsCost( mins, maxs );
+
+		// cost of creating a new parent for this node and the new leaf
+		float cost = 2.0f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		float inheritanceCost = 2.0f * ( combinedArea - area );
+
+		float childCost[ 2 ];
+
+		for ( int i = 0; i < 2; i++ )
+		{
+			const worldNode_t &child = sv_worldNodes[ node.children[ i ] ];
+
+			G_CM_BoundsUnion( child, leafNode, mins, maxs );
+			childCost[ i ] = G_CM_BoundsCost( mins, maxs ) + inheritanceCost;
+
+			if ( !G_CM_NodeIsLeaf( child ) )
+			{
+				childCost[ i ] -= G_CM_BoundsCost( child.absmin, child.absmax );
+			}
+		}
+
+		if ( cost < childCost[ 0 ] && cost < childCost[ 1 ] )
+		{
+			break;
+		}
+
+		index = node.children[ childCost[ 0 ] < childCost[ 1 ] ? 0 : 1 ];
 	}
 
-	VectorSubtract( maxs, mins, size );
+	int sibling = index;
+	int oldParent = sv_worldNodes[ sibling ].parent;
+	int newParent = G_CM_AllocNode();
 
-	if ( size[ 0 ] > size[ 1 ] )
+	worldNode_t &parentNode = sv_worldNodes[ newParent ];
+	parentNode.parent = oldParent;
+	parentNode.children[ 0 ] = sibling;
+	parentNode.children[ 1 ] = leaf;
+	sv_worldNodes[ sibling ].parent = newParent;
+	sv_worldNodes[ leaf ].parent = newParent;
+	G_CM_ReplaceChild( oldParent, sibling, newParent );
+
+	G_CM_RefitAncestors( newParent );
+}
+
+static void G_CM_RemoveLeaf( int leaf )
+{
+	if ( leaf == sv_worldRoot )
 	{
-		anode->axis = 0;
+		sv_worldRoot = -1;
+		return;
 	}
-	else
+
+	int parent = sv_worldNodes[ leaf ].parent;
+	const worldNode_t &parentNode = sv_worldNodes[ parent ];
+	int grandParent = parentNode.parent;
+	int sibling = parentNode.children[ parentNode.children[ 0 ] == leaf ? 1 : 0 ];
+
+	G_CM_ReplaceChild( grandParent, parent, sibling );
+	sv_worldNodes[ sibling ].parent = grandParent;
+	G_CM_FreeNode( parent );
+
+	G_CM_RefitAncestors( grandParent );
+}
+
+/*
+===============
+G_CM_SectorList_f
+
+Prints the shape of the world tree and the query statistics
+gathered since the previous call.
+===============
+*/
+void G_CM_SectorList_f()
+{
+	int leaves = 0, interior = 0, freeNodes = 0;
+	int leavesAtDepth[ 64 ] = {};
+	int maxDepth = 0;
+
+	for ( const worldNode_t &node : sv_worldNodes )
 	{
-		anode->axis = 1;
+		if ( node.height == -1 )
+		{
+			freeNodes++;
+			continue;
+		}
+
+		if ( !G_CM_NodeIsLeaf( node ) )
+		{
+			interior++;
+			continue;
+		}
+
+		leaves++;
+
+		int depth = 0;
+
+		for ( int i = node.parent; i != -1; i = sv_worldNodes[ i ].parent )
+		{
+			depth++;
+		}
+
+		depth = std::min( depth, int( ARRAY_LEN( leavesAtDepth ) - 1 ) );
+		leavesAtDepth[ depth ]++;
+		maxDepth = std::max( maxDepth, depth );
 	}
 
-	anode->dist = 0.5 * ( maxs[ anode->axis ] + mins[ anode->axis ] );
-	VectorCopy( mins, mins1 );
-	VectorCopy( mins, mins2 );
-	VectorCopy( maxs, maxs1 );
-	VectorCopy( maxs, maxs2 );
+	Log::Notice( "world tree: %i leaves, %i interior nodes, %i free nodes, height %i, margin %.1f",
+	             leaves, interior, freeNodes,
+	             sv_worldRoot == -1 ? 0 : sv_worldNodes[ sv_worldRoot ].height, sv_worldMargin );
 
-	maxs1[ anode->axis ] = mins2[ anode->axis ] = anode->dist;
+	for ( int i = 0; i <= maxDepth; i++ )
+	{
+		if ( leavesAtDepth[ i ] )
+		{
+			Log::Notice( "depth %i: %i entities", i, leavesAtDepth[ i ] );
+		}
+	}
+
+	int queries = std::max( sv_worldStats.queries, 1 );
 
-	anode->children[ 0 ] = G_CM_CreateworldSector( depth + 1, mins2, maxs2 );
-	anode->children[ 1 ] = G_CM_CreateworldSector( depth + 1, mins1, maxs1 );
+	Log::Notice( "%i queries: %.1f nodes visited, %.1f candidates, %.1f results per query",
+	             sv_worldStats.queries,
+	             sv_worldStats.nodesVisited / float( queries ),
+	             sv_worldStats.candidates / float( queries ),
+	             sv_worldStats.results / float( queries ) );
+	Log::Notice( "%i links, %i of them without touching the tree, %i reinsertions",
+	             sv_worldStats.links, sv_worldStats.linksInPlace, sv_worldStats.reinsertions );
 
-	return anode;
+	sv_worldStats = {};
 }
 
 /*
@@ -336,14 +760,28 @@ void G_CM_ClearWorld()
 	clipHandle_t h;
 	vec3_t       mins, maxs;
 
-	memset( sv_worldSectors, 0, sizeof( sv_worldSectors ) );
-	memset( wentities, 0, sizeof( wentities ) );
-	sv_numworldSectors = 0;
+	for ( worldEntity_t &went : wentities )
+	{
+		went.leaf = -1;
+	}
+
+	G_CM_ClearLeafCache();
+
+	sv_numOverridden = 0;
+	std::fill( std::begin( sv_overridden ), std::end( sv_overridden ), false );
 
-	// get world map bounds
+	// a leaf per entity, as many interior nodes
+	sv_worldNodes.clear();
+	sv_worldNodes.reserve( 2 * MAX_GENTITIES );
+	sv_worldRoot = -1;
+	sv_worldFreeNode = -1;
+	sv_worldStats = {};
+
+	// get world map bounds, the fat bounds margin grows with the map size
 	h = CM_InlineModel( 0 );
 	CM_ModelBounds( h, mins, maxs );
-	G_CM_CreateworldSector( 0, mins, maxs );
+	float size = std::max( { maxs[ 0 ] - mins[ 0 ], maxs[ 1 ] - mins[ 1 ], maxs[ 2 ] - mins[ 2 ] } );
+	sv_worldMargin = Math::Clamp( size / 1024.0f, 4.0f, 16.0f );
 }
 
 /*
@@ -354,38 +792,18 @@ G_CM_UnlinkEntity
 */
 void G_CM_UnlinkEntity( gentity_t *gEnt )
 {
-	worldEntity_t* scan;
-	worldSector_t* ws;
-
 	worldEntity_t* went = G_CM_WorldEntityForGentity( gEnt );
 
 	gEnt->r.linked = false;
 
-	ws = went->worldSector;
-
-	if ( !ws )
+	if ( went->leaf == -1 )
 	{
 		return; // not linked in anywhere
 	}
 
-	went->worldSector = nullptr;
-
-	if ( ws->entities == went )
-	{
-		ws->entities = went->nextEntityInWorldSector;
-		return;
-	}
-
-	for ( scan = ws->entities; scan; scan = scan->nextEntityInWorldSector )
-	{
-		if ( scan->nextEntityInWorldSector == went )
-		{
-			scan->nextEntityInWorldSector = went->nextEntityInWorldSector;
-			return;
-		}
-	}
-
-	Log::Warn( "G_CM_UnlinkEntity: not found in worldSector" );
+	G_CM_RemoveLeaf( went->leaf );
+	G_CM_FreeNode( went->leaf );
+	went->leaf = -1;
 }
 
 /*
@@ -397,7 +815,6 @@ G_CM_LinkEntity
 #define MAX_TOTAL_ENT_LEAFS 128
 void G_CM_LinkEntity( gentity_t *gEnt )
 {
-	worldSector_t *node;
 	int           leafs[ MAX_TOTAL_ENT_LEAFS ];
 	int           cluster;
 	int           num_leafs;
@@ -407,11 +824,6 @@ void G_CM_LinkEntity( gentity_t *gEnt )
 
 	worldEntity_t* went = G_CM_WorldEntityForGentity( gEnt );
 
-	if ( went->worldSector )
-	{
-		G_CM_UnlinkEntity( gEnt );  // unlink from old position
-	}
-
 	// encode the size into the entityState_t for client prediction
 	if ( gEnt->r.bmodel )
 	{
@@ -492,6 +904,22 @@ void G_CM_LinkEntity( gentity_t *gEnt )
 	gEnt->r.absmax[ 1 ] += 1;
 	gEnt->r.absmax[ 2 ] += 1;
 
+	if ( G_CM_BoundsOverride( gEnt ) )
+	{
+		// keep the rewound bounds until the override is cleared
+		boundsOverride_t &rewound = sv_boundsOverrides[ gEnt->num() ];
+		VectorCopy( gEnt->r.absmin, rewound.absmin );
+		VectorCopy( gEnt->r.absmax, rewound.absmax );
+	}
+	else
+	{
+		for ( int i = 0; i < 3; i++ )
+		{
+			sv_worldBounds[ gEnt->num() ].absmin[ i ] = gEnt->r.absmin[ i ];
+			sv_worldBounds[ gEnt->num() ].absmax[ i ] = gEnt->r.absmax[ i ];
+		}
+	}
+
 	// link to PVS leafs
 	gEnt->r.numClusters = 0;
 	gEnt->r.lastCluster = 0;
@@ -505,6 +933,11 @@ void G_CM_LinkEntity( gentity_t *gEnt )
 	// entity is outside the world and can be considered unlinked
 	if ( !num_leafs )
 	{
+		if ( went->leaf != -1 )
+		{
+			G_CM_UnlinkEntity( gEnt );
+		}
+
 		return;
 	}
 
@@ -548,35 +981,45 @@ void G_CM_LinkEntity( gentity_t *gEnt )
 	}
 
 	gEnt->r.linkcount++;
-
-	// find the first world sector node that the ent's box crosses
-	node = sv_worldSectors;
-
-	while ( 1 )
+	sv_worldStats.links++;
+
+	worldNode_t *node = went->leaf == -1 ? nullptr : &sv_worldNodes[ went->leaf ];
+
+	// still inside its fat bounds, the tree doesn't need to change
+	if ( node
+	     && node->absmin[ 0 ] <= gEnt->r.absmin[ 0 ]
+	     && node->absmin[ 1 ] <= gEnt->r.absmin[ 1 ]
+	     && node->absmin[ 2 ] <= gEnt->r.absmin[ 2 ]
+	     && node->absmax[ 0 ] >= gEnt->r.absmax[ 0 ]
+	     && node->absmax[ 1 ] >= gEnt->r.absmax[ 1 ]
+	     && node->absmax[ 2 ] >= gEnt->r.absmax[ 2 ] )
 	{
-		if ( node->axis == -1 )
-		{
-			break;
-		}
+		sv_worldStats.linksInPlace++;
+		gEnt->r.linked = true;
+		return;
+	}
 
-		if ( gEnt->r.absmin[ node->axis ] > node->dist )
-		{
-			node = node->children[ 0 ];
-		}
-		else if ( gEnt->r.absmax[ node->axis ] < node->dist )
-		{
-			node = node->children[ 1 ];
-		}
-		else
-		{
-			break; // crosses the node
-		}
+	if ( node )
+	{
+		G_CM_RemoveLeaf( went->leaf ); // unlink from old position
+		sv_worldStats.reinsertions++;
+	}
+	else
+	{
+		went->leaf = G_CM_AllocNode();
 	}
 
 	// link it in
-	went->worldSector = node;
-	went->nextEntityInWorldSector = node->entities;
-	node->entities = went;
+	worldNode_t &leaf = sv_worldNodes[ went->leaf ];
+	leaf.entityNum = gEnt->num();
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		leaf.absmin[ i ] = gEnt->r.absmin[ i ] - sv_worldMargin;
+		leaf.absmax[ i ] = gEnt->r.absmax[ i ] + sv_worldMargin;
+	}
+
+	G_CM_InsertLeaf( went->leaf );
 
 	gEnt->r.linked = true;
 }
@@ -591,94 +1034,263 @@ bounds.  This does NOT mean that they actually touch in the case of bmodels.
 ============================================================================
 */
 
-struct areaParms_t
+/*
+================
+G_CM_EntityBoundsOverlap
+
+Exact bounds test of a candidate entity, reading only its bounds record
+================
+*/
+static inline bool G_CM_EntityBoundsOverlap( int e, const vec3_t mins, const vec3_t maxs )
 {
-	const float *mins;
-	const float *maxs;
-	int         *list;
-	int         count, maxcount;
-};
+	const worldBounds_t &b = sv_worldBounds[ e ];
+
+	return b.absmin[ 0 ] <= maxs[ 0 ]
+	       && b.absmin[ 1 ] <= maxs[ 1 ]
+	       && b.absmin[ 2 ] <= maxs[ 2 ]
+	       && b.absmax[ 0 ] >= mins[ 0 ]
+	       && b.absmax[ 1 ] >= mins[ 1 ]
+	       && b.absmax[ 2 ] >= mins[ 2 ];
+}
 
 /*
-====================
-G_CM_AreaEntities_r
+================
+G_CM_FilterEntityBounds
 
-====================
+Copies the entities of the list whose bounds overlap mins / maxs to
+entityList, up to maxcount of them. Returns the number copied.
+================
+*/
+static int G_CM_FilterEntityBounds( const int *list, int num, const vec3_t mins, const vec3_t maxs,
+                                    int *entityList, int maxcount )
+{
+	int count = 0;
+
+	for ( int i = 0; i < num; i++ )
+	{
+		if ( !G_CM_EntityBoundsOverlap( list[ i ], mins, maxs ) )
+		{
+			continue;
+		}
+
+		if ( count == maxcount )
+		{
+			Log::Notice( "G_CM_AreaEntities: MAXCOUNT" );
+			break;
+		}
+
+		entityList[ count++ ] = list[ i ];
+	}
+
+	return count;
+}
+
+/*
+================
+G_CM_AreaEntities
+================
 */
-static void G_CM_AreaEntities_r( worldSector_t *node, areaParms_t *ap )
+int G_CM_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount )
 {
-	worldEntity_t     *check, *next;
-	gentity_t *gcheck;
-//	int             count;
+	int stack[ 256 ];
+	int stackSize = 0;
+	int count = 0;
+
+	TraceProfile::Timer timer( TraceProfile::Kind::AREA_ENTITIES );
+
+	sv_worldStats.queries++;
+
+	if ( sv_worldRoot == -1 )
+	{
+		return 0;
+	}
 
-//	count = 0;
+	stack[ stackSize++ ] = sv_worldRoot;
 
-	for ( check = node->entities; check; check = next )
+	while ( stackSize )
 	{
-		next = check->nextEntityInWorldSector;
+		const worldNode_t &node = sv_worldNodes[ stack[ --stackSize ] ];
+
+		sv_worldStats.nodesVisited++;
+
+		if ( node.absmin[ 0 ] > maxs[ 0 ]
+		     || node.absmin[ 1 ] > maxs[ 1 ]
+		     || node.absmin[ 2 ] > maxs[ 2 ]
+		     || node.absmax[ 0 ] < mins[ 0 ]
+		     || node.absmax[ 1 ] < mins[ 1 ]
+		     || node.absmax[ 2 ] < mins[ 2 ] )
+		{
+			continue;
+		}
 
-		gcheck = G_CM_GEntityForWorldEntity( check );
+		if ( !G_CM_NodeIsLeaf( node ) )
+		{
+			// the tree is balanced, its height can't come close to the stack size
+			ASSERT_LE( stackSize + 2, int( ARRAY_LEN( stack ) ) );
+			stack[ stackSize++ ] = node.children[ 0 ];
+			stack[ stackSize++ ] = node.children[ 1 ];
+			continue;
+		}
 
-		if ( !gcheck->r.linked )
+		// the rewound clients are added below instead
+		if ( node.entityNum < MAX_CLIENTS && sv_overridden[ node.entityNum ] )
 		{
 			continue;
 		}
 
-		if ( gcheck->r.absmin[ 0 ] > ap->maxs[ 0 ]
-		     || gcheck->r.absmin[ 1 ] > ap->maxs[ 1 ]
-		     || gcheck->r.absmin[ 2 ] > ap->maxs[ 2 ]
-		     || gcheck->r.absmax[ 0 ] < ap->mins[ 0 ]
-		     || gcheck->r.absmax[ 1 ] < ap->mins[ 1 ]
-		     || gcheck->r.absmax[ 2 ] < ap->mins[ 2 ] )
+		sv_worldStats.candidates++;
+
+		// the fat leaf bounds overlap, now check the exact bounds
+		// (only linked entities have a leaf, and each has at most one)
+		if ( !G_CM_EntityBoundsOverlap( node.entityNum, mins, maxs ) )
 		{
 			continue;
 		}
 
-		if ( ap->count == ap->maxcount )
+		if ( count == maxcount )
 		{
 			Log::Notice( "G_CM_AreaEntities: MAXCOUNT" );
-			return;
+			sv_worldStats.results += count;
+			return count;
 		}
 
-		ap->list[ ap->count ] = check - wentities;
-		ap->count++;
+		entityList[ count++ ] = node.entityNum;
 	}
 
-	if ( node->axis == -1 )
+	// their leaves are at their real positions, sv_worldBounds has the
+	// rewound bounds so they are filtered like the others
+	for ( int i = 0; i < sv_numOverridden; i++ )
 	{
-		return; // terminal node
+		int e = sv_overriddenList[ i ];
+
+		if ( !g_entities[ e ].r.linked )
+		{
+			continue;
+		}
+
+		sv_worldStats.candidates++;
+
+		if ( !G_CM_EntityBoundsOverlap( e, mins, maxs ) )
+		{
+			continue;
+		}
+
+		if ( count == maxcount )
+		{
+			Log::Notice( "G_CM_AreaEntities: MAXCOUNT" );
+			break;
+		}
+
+		entityList[ count++ ] = e;
 	}
 
-	// recurse down both sides
-	if ( ap->maxs[ node->axis ] > node->dist )
+	sv_worldStats.results += count;
+
+	return count;
+}
+
+/*
+============================================================================
+
+UNLAGGED BOUNDS OVERRIDES
+
+Unlagged traces clients at the position they had when the shooter saw them.
+Rather than relinking the clients there and back for every shot, their
+rewound bounds override the real ones in the queries and the clipping
+until cleared, and the world tree is left alone.
+============================================================================
+*/
+
+/*
+================
+G_CM_SetBoundsOverride
+
+Makes the queries and traces see the client at origin with the given box.
+================
+*/
+void G_CM_SetBoundsOverride( gentity_t *ent, const vec3_t origin, const vec3_t mins, const vec3_t maxs )
+{
+	int num = ent->num();
+
+	ASSERT_LT( num, MAX_CLIENTS );
+
+	boundsOverride_t &rewound = sv_boundsOverrides[ num ];
+
+	if ( !sv_overridden[ num ] )
 	{
-		G_CM_AreaEntities_r( node->children[ 0 ], ap );
+		for ( int i = 0; i < 3; i++ )
+		{
+			rewound.absmin[ i ] = sv_worldBounds[ num ].absmin[ i ];
+			rewound.absmax[ i ] = sv_worldBounds[ num ].absmax[ i ];
+		}
+
+		sv_overridden[ num ] = true;
+		sv_overriddenList[ sv_numOverridden++ ] = num;
 	}
 
-	if ( ap->mins[ node->axis ] < node->dist )
+	VectorCopy( origin, rewound.origin );
+	VectorCopy( mins, rewound.mins );
+	VectorCopy( maxs, rewound.maxs );
+
+	// same padding as G_CM_LinkEntity
+	for ( int i = 0; i < 3; i++ )
 	{
-		G_CM_AreaEntities_r( node->children[ 1 ], ap );
+		sv_worldBounds[ num ].absmin[ i ] = origin[ i ] + mins[ i ] - 1;
+		sv_worldBounds[ num ].absmax[ i ] = origin[ i ] + maxs[ i ] + 1;
 	}
 }
 
 /*
 ================
-G_CM_AreaEntities
+G_CM_ClearBoundsOverride
+
+Returns whether the client had its bounds overridden.
 ================
 */
-int G_CM_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount )
+bool G_CM_ClearBoundsOverride( gentity_t *ent )
 {
-	areaParms_t ap;
+	int num = ent->num();
+
+	if ( num >= MAX_CLIENTS || !sv_overridden[ num ] )
+	{
+		return false;
+	}
+
+	const boundsOverride_t &rewound = sv_boundsOverrides[ num ];
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		sv_worldBounds[ num ].absmin[ i ] = rewound.absmin[ i ];
+		sv_worldBounds[ num ].absmax[ i ] = rewound.absmax[ i ];
+	}
+
+	sv_overridden[ num ] = false;
+
+	for ( int i = 0; i < sv_numOverridden; i++ )
+	{
+		if ( sv_overriddenList[ i ] == num )
+		{
+			sv_overriddenList[ i ] = sv_overriddenList[ --sv_numOverridden ];
+			break;
+		}
+	}
+
+	return true;
+}
 
-	ap.mins = mins;
-	ap.maxs = maxs;
-	ap.list = entityList;
-	ap.count = 0;
-	ap.maxcount = maxcount;
+/*
+================
+G_CM_TraceOrigin
 
-	G_CM_AreaEntities_r( sv_worldSectors, &ap );
+The origin the queries and traces see for the entity, the rewound one while
+its bounds are overridden.
+================
+*/
+const float *G_CM_TraceOrigin( const gentity_t *ent )
+{
+	const boundsOverride_t *rewound = G_CM_BoundsOverride( ent );
 
-	return ap.count;
+	return rewound ? rewound->origin : ent->r.currentOrigin;
 }
 
 //===========================================================================
@@ -699,18 +1311,16 @@ struct moveclip_t
 
 /*
 ====================
-G_CM_ClipMoveToEntities
+G_CM_ClipMoveToEntityList
+
+Clips the move against the given candidate entities
 ====================
 */
-static void G_CM_ClipMoveToEntities( moveclip_t *clip )
+static void G_CM_ClipMoveToEntityList( moveclip_t *clip, const int *touchlist, int num )
 {
-	int            i, num;
-	int            touchlist[ MAX_GENTITIES ];
+	int            i;
 	gentity_t *touch;
 	trace_t        trace;
-	clipHandle_t   clipHandle;
-
-	num = G_CM_AreaEntities( clip->boxmins, clip->boxmaxs, touchlist, MAX_GENTITIES );
 
 	for ( i = 0; i < num; i++ )
 	{
@@ -748,18 +1358,8 @@ static void G_CM_ClipMoveToEntities( moveclip_t *clip )
 		}
 
 		// might intersect, so do an exact clip
-		clipHandle = G_CM_ClipHandleForEntity( touch );
-
-		const float *origin = touch->r.currentOrigin;
-		const float *angles = touch->r.currentAngles;
-
-		if ( !touch->r.bmodel )
-		{
-			angles = vec3_origin; // boxes don't rotate
-		}
-
-		CM_TransformedBoxTrace( &trace, clip->start, clip->end, clip->mins, clip->maxs, clipHandle,
-		                        clip->contentmask, 0, origin, angles, clip->collisionType );
+		G_CM_ClipToEntity( &trace, touch, clip->start, clip->end, clip->mins, clip->maxs,
+		                   clip->contentmask, clip->collisionType );
 
 		if ( trace.allsolid )
 		{
@@ -784,6 +1384,78 @@ static void G_CM_ClipMoveToEntities( moveclip_t *clip )
 	}
 }
 
+/*
+====================
+G_CM_ClipMoveToEntities
+====================
+*/
+static void G_CM_ClipMoveToEntities( moveclip_t *clip )
+{
+	int touchlist[ MAX_GENTITIES ];
+	int num;
+
+	num = G_CM_AreaEntities( clip->boxmins, clip->boxmaxs, touchlist, MAX_GENTITIES );
+
+	G_CM_ClipMoveToEntityList( clip, touchlist, num );
+}
+
+/*
+==================
+G_CM_ClipMoveToWorld
+
+Clips the move against the world and sets up the remaining
+fields of the clip for the entity checks.
+Returns false if the move is blocked immediately by the world.
+==================
+*/
+static bool G_CM_ClipMoveToWorld( moveclip_t *clip, const vec3_t start, const vec3_t mins, const vec3_t maxs,
+                                  const vec3_t end, int passEntityNum, int contentmask, int skipmask,
+                                  traceType_t type )
+{
+	int i;
+
+	// clip to world
+	// -------------
+
+	CM_BoxTrace( &clip->trace, start, end, mins, maxs, 0, contentmask, skipmask, type );
+	clip->trace.entityNum = clip->trace.fraction == 1.0 ? ENTITYNUM_NONE : ENTITYNUM_WORLD;
+
+	if ( clip->trace.allsolid )
+	{
+		return false; // blocked immediately by the world
+	}
+
+	clip->contentmask = contentmask;
+	clip->skipmask = skipmask;
+	clip->start = start;
+//  VectorCopy( clip->trace.endpos, clip->end );
+	VectorCopy( end, clip->end );
+	clip->mins = mins;
+	clip->maxs = maxs;
+	clip->passEntityNum = passEntityNum;
+	clip->collisionType = type;
+
+	// create the bounding box of the entire move
+	// we can limit it to the part of the move not
+	// already clipped off by the world, which can be
+	// a significant savings for line of sight and shot traces
+	for ( i = 0; i < 3; i++ )
+	{
+		if ( end[ i ] > start[ i ] )
+		{
+			clip->boxmins[ i ] = clip->start[ i ] + clip->mins[ i ] - 1;
+			clip->boxmaxs[ i ] = clip->end[ i ] + clip->maxs[ i ] + 1;
+		}
+		else
+		{
+			clip->boxmins[ i ] = clip->end[ i ] + clip->mins[ i ] - 1;
+			clip->boxmaxs[ i ] = clip->start[ i ] + clip->maxs[ i ] + 1;
+		}
+	}
+
+	return true;
+}
+
 /*
 ==================
 G_CM_Trace
@@ -796,7 +1468,7 @@ void G_CM_Trace( trace_t *results, const vec3_t start, const vec3_t mins2, const
                  const vec3_t end, int passEntityNum, int contentmask, int skipmask,
                  traceType_t type )
 {
-	int        i;
+	TraceProfile::Timer timer( TraceProfile::Kind::TRACE );
 
 	if ( !mins2 )
 	{
@@ -814,53 +1486,70 @@ void G_CM_Trace( trace_t *results, const vec3_t start, const vec3_t mins2, const
 
 	moveclip_t clip{};
 
-	// clip to world
-	// -------------
+	if ( G_CM_ClipMoveToWorld( &clip, start, mins, maxs, end, passEntityNum, contentmask, skipmask, type ) )
+	{
+		// clip to other solid entities
+		G_CM_ClipMoveToEntities( &clip );
+	}
+
+	*results = clip.trace;
+}
+
+/*
+==================
+G_CM_TraceBatch
+
+Performs the same work as a G_CM_Trace for each request, but gathers the
+candidate entities only once for the union of all the moves.
+Meant for bundles of traces that sweep roughly the same volume.
+==================
+*/
+void G_CM_TraceBatch( const traceRequest_t *requests, trace_t *results, int n )
+{
+	// scratch space, tracing never comes back in here
+	static int touchlist[ MAX_GENTITIES ];
+	static int sublist[ MAX_GENTITIES ];
+	vec3_t unionmins, unionmaxs;
+	int    i, j, num;
 
-	CM_BoxTrace( &clip.trace, start, end, mins, maxs, 0, contentmask, skipmask, type );
-	clip.trace.entityNum = clip.trace.fraction == 1.0 ? ENTITYNUM_NONE : ENTITYNUM_WORLD;
+	TraceProfile::Timer timer( TraceProfile::Kind::TRACE_BATCH );
 
-	if ( clip.trace.allsolid )
+	if ( n <= 0 )
 	{
-		*results = clip.trace;
-		return; // blocked immediately by the world
+		return;
 	}
 
-	// clip to entities
-	// ----------------
-
-	clip.contentmask = contentmask;
-	clip.skipmask = skipmask;
-	clip.start = start;
-//  VectorCopy( clip.trace.endpos, clip.end );
-	VectorCopy( end, clip.end );
-	clip.mins = mins;
-	clip.maxs = maxs;
-	clip.passEntityNum = passEntityNum;
-	clip.collisionType = type;
+	ClearBounds( unionmins, unionmaxs );
 
-	// create the bounding box of the entire move
-	// we can limit it to the part of the move not
-	// already clipped off by the world, which can be
-	// a significant savings for line of sight and shot traces
-	for ( i = 0; i < 3; i++ )
+	for ( i = 0; i < n; i++ )
 	{
-		if ( end[ i ] > start[ i ] )
-		{
-			clip.boxmins[ i ] = clip.start[ i ] + clip.mins[ i ] - 1;
-			clip.boxmaxs[ i ] = clip.end[ i ] + clip.maxs[ i ] + 1;
-		}
-		else
+		const traceRequest_t &req = requests[ i ];
+
+		for ( j = 0; j < 3; j++ )
 		{
-			clip.boxmins[ i ] = clip.end[ i ] + clip.mins[ i ] - 1;
-			clip.boxmaxs[ i ] = clip.start[ i ] + clip.maxs[ i ] + 1;
+			unionmins[ j ] = std::min( unionmins[ j ], std::min( req.start[ j ], req.end[ j ] ) + req.mins[ j ] - 1 );
+			unionmaxs[ j ] = std::max( unionmaxs[ j ], std::max( req.start[ j ], req.end[ j ] ) + req.maxs[ j ] + 1 );
 		}
 	}
 
-	// clip to other solid entities
-	G_CM_ClipMoveToEntities( &clip );
+	num = G_CM_AreaEntities( unionmins, unionmaxs, touchlist, MAX_GENTITIES );
 
-	*results = clip.trace;
+	for ( i = 0; i < n; i++ )
+	{
+		const traceRequest_t &req = requests[ i ];
+		moveclip_t clip{};
+
+		if ( G_CM_ClipMoveToWorld( &clip, req.start, req.mins, req.maxs, req.end, req.passEntityNum,
+		                           req.contentmask, req.skipmask, req.type ) )
+		{
+			// only keep the candidates this move can touch
+			int subnum = G_CM_FilterEntityBounds( touchlist, num, clip.boxmins, clip.boxmaxs, sublist, MAX_GENTITIES );
+
+			G_CM_ClipMoveToEntityList( &clip, sublist, subnum );
+		}
+
+		results[ i ] = clip.trace;
+	}
 }
 
 static trace2_t ConvertTrace( const trace_t &tr, const vec3_t start, int entityNum )
@@ -886,9 +1575,11 @@ static trace2_t ConvertTrace( const trace_t &tr, const vec3_t start, int entityN
 	return result;
 }
 
-trace2_t G_Trace2( const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
+trace2_t ( G_Trace2 )( const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end,
 		int passEntityNum, int contentmask, int skipmask, traceType_t type )
 {
+	TraceProfile::Timer timer( TraceProfile::Kind::TRACE2 );
+
 	// clip to world
 	// -------------
 
@@ -967,18 +1658,7 @@ trace2_t G_Trace2( const vec3_t start, const vec3_t mins, const vec3_t maxs, con
 		}
 
 		// might intersect, so do an exact clip
-		clipHandle_t clipHandle = G_CM_ClipHandleForEntity( touch );
-
-		const float *origin = touch->r.currentOrigin;
-		const float *angles = touch->r.currentAngles;
-
-		if ( !touch->r.bmodel )
-		{
-			angles = vec3_origin; // boxes don't rotate
-		}
-
-		CM_TransformedBoxTrace( &trace, start, end, mins, maxs, clipHandle,
-		                        contentmask, 0, origin, angles, type );
+		G_CM_ClipToEntity( &trace, touch, start, end, mins, maxs, contentmask, type );
 
 		if ( trace.startsolid )
 		{
@@ -998,8 +1678,9 @@ trace2_t G_Trace2( const vec3_t start, const vec3_t mins, const vec3_t maxs, con
 G_CM_PointContents
 =============
 */
-int G_CM_PointContents( const vec3_t p, int passEntityNum )
+int ( G_CM_PointContents )( const vec3_t p, int passEntityNum )
 {
+	TraceProfile::Timer timer( TraceProfile::Kind::POINT_CONTENTS );
 	int            touch[ MAX_GENTITIES ];
 	gentity_t *hit;
 	int            i, num;
@@ -1021,8 +1702,20 @@ int G_CM_PointContents( const vec3_t p, int passEntityNum )
 		}
 
 		hit = &g_entities[ touch[ i ] ];
+
+		const float *origin = hit->r.currentOrigin;
+		const boundsOverride_t *rewound = G_CM_BoundsOverride( hit );
+
 		// might intersect, so do an exact clip
-		clipHandle = G_CM_ClipHandleForEntity( hit );
+		if ( rewound )
+		{
+			origin = rewound->origin;
+			clipHandle = G_CM_ClipHandleForEntity( hit, rewound->mins, rewound->maxs );
+		}
+		else
+		{
+			clipHandle = G_CM_ClipHandleForEntity( hit, hit->r.mins, hit->r.maxs );
+		}
 
 		// ydnar: non-worldspawn entities must not use world as clip model!
 		if ( clipHandle == 0 )
@@ -1039,7 +1732,7 @@ int G_CM_PointContents( const vec3_t p, int passEntityNum )
 		                }
 		*/
 
-		c2 = CM_TransformedPointContents( p, clipHandle, hit->r.currentOrigin, hit->r.currentAngles );
+		c2 = CM_TransformedPointContents( p, clipHandle, origin, hit->r.currentAngles );
 
 		contents |= c2;
 	}
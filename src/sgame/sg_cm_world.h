@@ -38,6 +38,7 @@ Maryland 20850 USA.
 #define SG_CM_WORLD_H_
 
 #include "common/cm/cm_public.h"
+#include "shared/TraceProfile.h"
 
 void G_CM_ClearWorld();
 
@@ -69,6 +70,14 @@ int          G_CM_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entit
 // returns the number of pointers filled in
 // The world entity is never returned in this list.
 
+void G_CM_SetBoundsOverride( gentity_t *ent, const vec3_t origin, const vec3_t mins, const vec3_t maxs );
+bool G_CM_ClearBoundsOverride( gentity_t *ent );
+const float *G_CM_TraceOrigin( const gentity_t *ent );
+
+// until cleared, the area queries, traces and contents checks see the client
+// ent at origin with the box mins / maxs instead of where it is linked,
+// without touching the world tree. Used for unlagged.
+
 int G_CM_PointContents( const vec3_t p, int passEntityNum );
 
 // returns the CONTENTS_* value from the world and all entities at the given point.
@@ -88,6 +97,25 @@ void G_CM_Trace( trace_t *results, const vec3_t start, const vec3_t mins, const
 // passEntityNum, if isn't ENTITYNUM_NONE, will be explicitly excluded from clipping checks
 
 
+// a single trace of a G_CM_TraceBatch; mins and maxs are relative and zero for a point trace
+struct traceRequest_t
+{
+	vec3_t      start;
+	vec3_t      mins;
+	vec3_t      maxs;
+	vec3_t      end;
+	int         passEntityNum = ENTITYNUM_NONE;
+	int         contentmask = 0;
+	int         skipmask = 0;
+	traceType_t type = traceType_t::TT_AABB;
+};
+
+// same results as a G_CM_Trace for each request, but the candidate entities
+// are gathered only once for the union of all the moves; useful for groups
+// of traces sweeping about the same volume such as shotgun pellets
+void G_CM_TraceBatch( const traceRequest_t *requests, trace_t *results, int n );
+
+
 // G_Trace2: an alternative to trap_Trace (a.k.a. G_CM_Trace) with different startsolid semantics
 // In a standard trace, if there is a brush/entity/facet that overlaps the starting point but not
 // the ending point, it makes the startsolid flag get set but is otherwise ignored.
@@ -129,10 +157,19 @@ bool G_CM_inPVS( const vec3_t p1, const vec3_t p2 );
 
 bool G_CM_inPVSIgnorePortals( const vec3_t p1, const vec3_t p2 );
 
+// the same checks between the s.origin of two entities, cached until they move
+bool G_EntitiesInPVS( gentity_t *a, gentity_t *b );
+bool G_EntitiesInPVSIgnorePortals( gentity_t *a, gentity_t *b );
+
 void G_CM_AdjustAreaPortalState( gentity_t *ent, bool open );
 
 bool G_CM_EntityContact( const vec3_t mins, const vec3_t maxs, const gentity_t *gEnt, traceType_t type );
 
 void G_CM_SetBrushModel( gentity_t *ent, const char *name );
 
+// attribute the queries made by gameplay code to their call site, see TraceProfile.h
+// (the definitions use parenthesized names to escape these)
+#define G_Trace2( ... ) TRACE_PROFILE_CALL( G_Trace2( __VA_ARGS__ ) )
+#define G_CM_PointContents( ... ) TRACE_PROFILE_CALL( G_CM_PointContents( __VA_ARGS__ ) )
+
 #endif // SG_CM_WORLD_H_
@@ -4139,7 +4139,7 @@ static void Cmd_Beacon_f( gentity_t *ent )
 	AngleVectors( ent->client->ps.viewangles, forward, nullptr, nullptr );
 	VectorMA( origin, 65536, forward, end );
 
-	G_UnlaggedOn( ent, origin, 65536 );
+	G_UnlaggedOn( ent, origin, end, 0.0f );
 	trap_Trace( &tr, origin, nullptr, nullptr, end, ent->num(), MASK_PLAYERSOLID, 0 );
 	G_UnlaggedOff( );
 
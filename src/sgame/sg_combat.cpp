@@ -26,6 +26,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "common/Common.h"
 #include "sg_local.h"
+#include "sg_cm_world.h"
 #include "Entities.h"
 #include "CBSE.h"
 
@@ -956,6 +957,104 @@ void G_SelectiveDamage( gentity_t *targ, gentity_t * /*inflictor*/, gentity_t *a
 	}
 }
 
+struct radiusTarget_t
+{
+	gentity_t *ent;
+	float     points;
+	bool      canDamage;
+};
+
+// Radius damage comes back into itself when it kills something that explodes,
+// so each call appends its targets past the ones of the calls it is nested in.
+static std::vector<radiusTarget_t> radiusTargets;
+
+/**
+ * @brief Batched G_CanDamage, the traces towards all the targets share their
+ *        entity candidates. Radius damage checks all its targets before
+ *        damaging any, so a target destroyed by the blast still shields the
+ *        ones behind it.
+ * @param targets whose canDamage is set to whether the inflictor can directly damage them.
+ * @param n
+ * @param origin
+ */
+static void G_CanDamageMany( radiusTarget_t *targets, int n, const vec3_t origin )
+{
+	// this should probably check in the plane of projection,
+	// rather than in world coordinate, and also include Z
+	static const float cornerOffsets[ 4 ][ 2 ] = { { 15, 15 }, { 15, -15 }, { -15, 15 }, { -15, -15 } };
+
+	// scratch space, reused from call to call
+	static std::vector<traceRequest_t> requests;
+	static std::vector<trace_t> results;
+	static std::vector<int> blocked;
+
+	if ( n <= 0 )
+	{
+		return;
+	}
+
+	requests.resize( n );
+	results.resize( n );
+	blocked.clear();
+
+	for ( int i = 0; i < n; i++ )
+	{
+		traceRequest_t &req = requests[ i ];
+
+		// use the midpoint of the bounds instead of the origin, because
+		// bmodels may have their origin is 0,0,0
+		VectorAdd( targets[ i ].ent->r.absmin, targets[ i ].ent->r.absmax, req.end );
+		VectorScale( req.end, 0.5, req.end );
+		VectorCopy( origin, req.start );
+		req.contentmask = MASK_SOLID;
+	}
+
+	G_CM_TraceBatch( requests.data(), results.data(), n );
+
+	for ( int i = 0; i < n; i++ )
+	{
+		targets[ i ].canDamage = results[ i ].fraction == 1.0 || results[ i ].entityNum == targets[ i ].ent->num();
+
+		if ( !targets[ i ].canDamage )
+		{
+			blocked.push_back( i );
+		}
+	}
+
+	if ( blocked.empty() )
+	{
+		return;
+	}
+
+	// try around the midpoint of the targets that are not directly visible,
+	// the corner requests go after the midpoint ones
+	requests.resize( n + 4 * blocked.size() );
+	results.resize( requests.size() );
+
+	traceRequest_t *corner = &requests[ n ];
+
+	for ( int i : blocked )
+	{
+		for ( const float *offset : cornerOffsets )
+		{
+			*corner = requests[ i ];
+			corner->end[ 0 ] += offset[ 0 ];
+			corner->end[ 1 ] += offset[ 1 ];
+			corner++;
+		}
+	}
+
+	G_CM_TraceBatch( &requests[ n ], &results[ n ], 4 * blocked.size() );
+
+	for ( size_t i = 0; i < 4 * blocked.size(); i++ )
+	{
+		if ( results[ n + i ].fraction == 1.0 )
+		{
+			targets[ blocked[ i / 4 ] ].canDamage = true;
+		}
+	}
+}
+
 /**
  * @brief Used for explosions and melee attacks.
  * @param targ
@@ -1029,10 +1128,12 @@ bool G_CanDamage( gentity_t *targ, const vec3_t origin )
 bool G_SelectiveRadiusDamage( const vec3_t origin, gentity_t *attacker, float damage,
                                   float radius, gentity_t *ignore, int mod, int ignoreTeam )
 {
-	float     points, dist;
+	float     dist;
 	gentity_t *ent;
 	int       entityList[ MAX_GENTITIES ];
 	int       numListedEntities;
+	size_t    firstTarget = radiusTargets.size();
+	int       numTargets = 0;
 	vec3_t    mins, maxs;
 	int       i, e;
 	bool  hitClient = false;
@@ -1072,26 +1173,43 @@ bool G_SelectiveRadiusDamage( const vec3_t origin, gentity_t *attacker, float da
 			continue;
 		}
 
-		points = damage * ( 1.0 - dist / radius );
+		if ( !ent->client || ent->client->pers.team == ignoreTeam )
+		{
+			continue;
+		}
+
+		radiusTargets.push_back( { ent, damage * ( 1.0f - dist / radius ), false } );
+		numTargets++;
+	}
+
+	G_CanDamageMany( radiusTargets.data() + firstTarget, numTargets, origin );
+
+	for ( e = 0; e < numTargets; e++ )
+	{
+		// the damage may add targets of its own and move the array
+		radiusTarget_t target = radiusTargets[ firstTarget + e ];
 
-		if ( G_CanDamage( ent, origin ) && ent->client &&
-		     ent->client->pers.team != ignoreTeam )
+		if ( target.canDamage )
 		{
-			hitClient = ent->Damage(points, attacker, VEC2GLM( origin ), Util::nullopt,
+			hitClient = target.ent->Damage(target.points, attacker, VEC2GLM( origin ), Util::nullopt,
 			                                DAMAGE_NO_LOCDAMAGE, (meansOfDeath_t)mod);
 		}
 	}
 
+	radiusTargets.resize( firstTarget );
+
 	return hitClient;
 }
 
 bool G_RadiusDamage( const vec3_t origin, gentity_t *attacker, float damage,
                          float radius, gentity_t *ignore, int dflags, int mod, team_t testHit )
 {
-	float     points, dist;
+	float     dist;
 	gentity_t *ent;
 	int       entityList[ MAX_GENTITIES ];
 	int       numListedEntities;
+	size_t    firstTarget = radiusTargets.size();
+	int       numTargets = 0;
 	vec3_t    mins, maxs;
 	vec3_t    dir;
 	int       i, e;
@@ -1127,9 +1245,19 @@ bool G_RadiusDamage( const vec3_t origin, gentity_t *attacker, float damage,
 			continue;
 		}
 
-		points = damage * ( 1.0 - dist / radius );
+		radiusTargets.push_back( { ent, damage * ( 1.0f - dist / radius ), false } );
+		numTargets++;
+	}
+
+	G_CanDamageMany( radiusTargets.data() + firstTarget, numTargets, origin );
 
-		if ( G_CanDamage( ent, origin ) )
+	for ( e = 0; e < numTargets; e++ )
+	{
+		// the damage may add targets of its own and move the array
+		radiusTarget_t target = radiusTargets[ firstTarget + e ];
+		ent = target.ent;
+
+		if ( target.canDamage )
 		{
 			if ( testHit == TEAM_NONE )
 			{
@@ -1139,16 +1267,19 @@ bool G_RadiusDamage( const vec3_t origin, gentity_t *attacker, float damage,
 				dir[ 2 ] += 24;
 				VectorNormalize( dir );
 
-				hitSomething = ent->Damage(points, attacker, VEC2GLM( origin ), VEC2GLM( dir ),
+				hitSomething = ent->Damage(target.points, attacker, VEC2GLM( origin ), VEC2GLM( dir ),
 				                                   (DAMAGE_NO_LOCDAMAGE | dflags), (meansOfDeath_t)mod);
 			}
 			else if ( G_Team( ent ) == testHit && Entities::IsAlive( ent ) )
 			{
-				return true;
+				hitSomething = true;
+				break;
 			}
 		}
 	}
 
+	radiusTargets.resize( firstTarget );
+
 	return hitSomething;
 }
 
@@ -64,7 +64,7 @@ void G_InitGentity( gentity_t *entity )
 	++entity->generation;
 	entity->inuse = true;
 	entity->enabled = true;
-	entity->classname = BG_strdup( "noclass" );
+	G_SetClassname( entity, "noclass" );
 	entity->s.number = entity->num();
 	entity->r.ownerNum = ENTITYNUM_NONE;
 	entity->creationTime = level.time;
@@ -75,6 +75,61 @@ void G_InitGentity( gentity_t *entity )
 	}
 }
 
+/*
+=================
+Free entity slots
+
+The freed slots above the client range are kept in a list ordered by
+freetime, so the front of the list is always the slot that was freed the
+longest time ago. The slots that are old enough to be reused form a prefix
+of the list, and the recently freed ones the rest of it.
+=================
+*/
+
+static int freeSlotFirst = -1;
+static int freeSlotLast = -1;
+static int freeSlotNext[ MAX_GENTITIES ];
+static int freeSlotPrev[ MAX_GENTITIES ];
+static bool freeSlotListed[ MAX_GENTITIES ];
+
+static void RemoveFreeSlot( int entityNum )
+{
+	int prev = freeSlotPrev[ entityNum ];
+	int next = freeSlotNext[ entityNum ];
+
+	if ( prev != -1 )
+		freeSlotNext[ prev ] = next;
+	else
+		freeSlotFirst = next;
+
+	if ( next != -1 )
+		freeSlotPrev[ next ] = prev;
+	else
+		freeSlotLast = prev;
+
+	freeSlotListed[ entityNum ] = false;
+}
+
+static void AppendFreeSlot( int entityNum )
+{
+	if ( freeSlotListed[ entityNum ] )
+	{
+		RemoveFreeSlot( entityNum ); // freed again, its freetime changed
+	}
+
+	freeSlotPrev[ entityNum ] = freeSlotLast;
+	freeSlotNext[ entityNum ] = -1;
+
+	if ( freeSlotLast != -1 )
+		freeSlotNext[ freeSlotLast ] = entityNum;
+	else
+		freeSlotFirst = entityNum;
+
+	freeSlotLast = entityNum;
+
+	freeSlotListed[ entityNum ] = true;
+}
+
 /*
 =================
 FindEntitySlot
@@ -92,47 +147,38 @@ angles and bad trails.
 */
 static gentity_t *FindEntitySlot()
 {
-	// we iterate through all the entities and look for a free one that was allocated enough time ago,
-	// as well as one that died recently in case the first kind is not available
-	gentity_t *newEntity = &g_entities[ MAX_CLIENTS ];
-	gentity_t *forcedEnt = nullptr;
-	int i;
-
-	for ( i = MAX_CLIENTS; i < level.num_entities; i++, newEntity++ )
+	// the oldest freed slot, if it was allocated enough time ago
+	if ( freeSlotFirst != -1 )
 	{
-		if ( newEntity->inuse )
-		{
-			continue;
-		}
+		gentity_t *oldest = &g_entities[ freeSlotFirst ];
 
 		// the first couple seconds of server time can involve a lot of
 		// freeing and allocating, so relax the replacement policy
-		if ( newEntity->freetime > level.startTime + 2000 && level.time - newEntity->freetime < 1000 )
+		if ( !( oldest->freetime > level.startTime + 2000 && level.time - oldest->freetime < 1000 ) )
 		{
-			if( ! forcedEnt || newEntity->freetime < forcedEnt->freetime ) {
-				forcedEnt = newEntity;
-			}
-			continue;
+			// reuse this slot
+			RemoveFreeSlot( freeSlotFirst );
+			return oldest;
 		}
-
-		// reuse this slot
-		return newEntity;
 	}
 
-	if ( i == ENTITYNUM_MAX_NORMAL )
+	if ( level.num_entities == ENTITYNUM_MAX_NORMAL )
 	{
 		// no more entities available! let's force-reuse one if possible, or die
-		if ( forcedEnt )
+		if ( freeSlotFirst != -1 )
 		{
+			gentity_t *forcedEnt = &g_entities[ freeSlotFirst ];
+
 			if ( g_debugEntities.Get() ) {
 				Log::Verbose( "Reusing Entity %i, freed at %i (%ims ago)",
 				              forcedEnt->num(), forcedEnt->freetime, level.time - forcedEnt->freetime );
 			}
 			// reuse this slot
+			RemoveFreeSlot( freeSlotFirst );
 			return forcedEnt;
 		}
 
-		for ( i = 0; i < MAX_GENTITIES; i++ )
+		for ( int i = 0; i < MAX_GENTITIES; i++ )
 		{
 			Log::Warn( "%4i: %s", i, g_entities[ i ].classname );
 		}
@@ -140,6 +186,8 @@ static gentity_t *FindEntitySlot()
 		Sys::Drop( "FindEntitySlot: no free entities" );
 	}
 
+	gentity_t *newEntity = &g_entities[ level.num_entities ];
+
 	// open up a new slot
 	level.num_entities++;
 
@@ -190,6 +238,8 @@ void G_FreeEntity( gentity_t *entity )
 		G_ForgetEntityId( entity->id );
 	}
 
+	G_ForgetEntityNames( entity );
+
 	delete entity->entity;
 
 	unsigned generation = entity->generation;
@@ -210,9 +260,15 @@ void G_FreeEntity( gentity_t *entity )
 
 	entity->generation = generation + 1;
 	entity->entity = nullptr;
-	entity->classname = BG_strdup( "freent" );
 	entity->freetime = level.time;
 	entity->inuse = false;
+	// drops the entity from the classname index, free entities are not indexed
+	G_SetClassname( entity, "freent" );
+
+	if ( entity->num() >= MAX_CLIENTS && entity->num() < level.num_entities )
+	{
+		AppendFreeSlot( entity->num() );
+	}
 }
 
 
@@ -232,7 +288,7 @@ gentity_t *G_NewTempEntity( glm::vec3 origin, int event )
 	newEntity = G_NewEntity( NO_CBSE );
 	newEntity->s.eType = Util::enum_cast<entityType_t>( Util::ordinal(entityType_t::ET_EVENTS) + event );
 
-	newEntity->classname = BG_strdup( "tempEntity" );
+	G_SetClassname( newEntity, "tempEntity" );
 	newEntity->eventTime = level.time;
 	newEntity->freeAfterEvent = true;
 
@@ -253,18 +309,6 @@ gentity debugging
 =================================================================================
 */
 
-static bool matchesName( mapEntity_t const& ent, std::string const& name )
-{
-	for ( char const* n : ent.names )
-	{
-		if ( n && !Q_stricmp( name.c_str(), n ) )
-		{
-			return true;
-		}
-	}
-	return false;
-}
-
 std::string etos( const gentity_t *entity )
 {
 	if ( !entity ) {
@@ -297,6 +341,158 @@ gentity list handling and searching
 =================================================================================
 */
 
+/*
+=============
+Classname index
+
+Classnames are interned to small integer ids, case insensitively like the
+Q_stricmp of a linear search, and the entities of each class are chained
+in entity number order so that class lookups only visit the matches.
+Freed entities are not indexed, they never match a search.
+=============
+*/
+
+static std::unordered_map<std::string, int> classnameIds;
+static std::vector<int> classFirst;         // first entity of each class, -1 if none
+static int entityClassId[ MAX_GENTITIES ];  // interned id + 1, 0 if not indexed
+static int entityClassNext[ MAX_GENTITIES ];
+static int entityClassPrev[ MAX_GENTITIES ];
+
+// key for the name indexes, which match case insensitively like Q_stricmp
+static std::string G_NameKey( const char *name )
+{
+	std::string key = name;
+
+	for ( char &c : key )
+	{
+		c = tolower( static_cast<unsigned char>( c ) );
+	}
+
+	return key;
+}
+
+static int G_ClassnameId( const char *classname, bool create )
+{
+	std::string key = G_NameKey( classname );
+
+	auto it = classnameIds.find( key );
+
+	if ( it != classnameIds.end() )
+	{
+		return it->second;
+	}
+
+	if ( !create )
+	{
+		return -1;
+	}
+
+	int id = classFirst.size();
+	classnameIds.emplace( std::move( key ), id );
+	classFirst.push_back( -1 );
+	return id;
+}
+
+static void G_UnindexClassname( int entityNum )
+{
+	int id = entityClassId[ entityNum ] - 1;
+
+	if ( id < 0 )
+	{
+		return;
+	}
+
+	int prev = entityClassPrev[ entityNum ];
+	int next = entityClassNext[ entityNum ];
+
+	if ( prev != -1 )
+	{
+		entityClassNext[ prev ] = next;
+	}
+	else
+	{
+		classFirst[ id ] = next;
+	}
+
+	if ( next != -1 )
+	{
+		entityClassPrev[ next ] = prev;
+	}
+
+	entityClassId[ entityNum ] = 0;
+}
+
+static void G_IndexClassname( int entityNum, const char *classname )
+{
+	int id = G_ClassnameId( classname, true );
+	int prev = -1;
+	int next = classFirst[ id ];
+
+	while ( next != -1 && next < entityNum )
+	{
+		prev = next;
+		next = entityClassNext[ next ];
+	}
+
+	entityClassPrev[ entityNum ] = prev;
+	entityClassNext[ entityNum ] = next;
+
+	if ( prev != -1 )
+	{
+		entityClassNext[ prev ] = entityNum;
+	}
+	else
+	{
+		classFirst[ id ] = entityNum;
+	}
+
+	if ( next != -1 )
+	{
+		entityClassPrev[ next ] = entityNum;
+	}
+
+	entityClassId[ entityNum ] = id + 1;
+}
+
+/*
+=============
+G_SetClassname
+
+Entity classnames must only be changed through this, to keep the index up to date
+=============
+*/
+void G_SetClassname( gentity_t *entity, const char *classname )
+{
+	int entityNum = entity->num();
+
+	entity->classname = BG_strdup( classname );
+
+	G_UnindexClassname( entityNum );
+
+	if ( entity->inuse )
+	{
+		G_IndexClassname( entityNum, classname );
+	}
+}
+
+static bool G_EntityMatches( gentity_t *entity, bool skipdisabled, size_t fieldofs, const char *match )
+{
+	if ( !entity->inuse )
+		return false;
+
+	if( skipdisabled && !entity->enabled)
+		return false;
+
+	if ( fieldofs && match )
+	{
+		char *fieldString = * ( char ** )( ( byte * ) entity + fieldofs );
+		if ( Q_stricmp( fieldString, match ) )
+			return false;
+	}
+
+	return true;
+}
+
 /*
 =============
 G_IterateEntities
@@ -312,14 +508,60 @@ Set nullptr as previous gentity to start the iteration from the beginning
 */
 gentity_t *G_IterateEntities( gentity_t *entity, const char *classname, bool skipdisabled, size_t fieldofs, const char *match )
 {
-	char *fieldString;
+	//start after the reserved player slots, if we are not searching for a player
+	bool skipClients = classname && !strcmp( classname, S_PLAYER_CLASSNAME );
+
+	if ( !classname && fieldofs == FOFS( classname ) && match )
+	{
+		// looking up the classname field is a class lookup
+		classname = match;
+		fieldofs = 0;
+		match = nullptr;
+	}
+
+	if ( classname )
+	{
+		int num;
+
+		if ( entity && entityClassId[ entity->num() ] && !Q_stricmp( entity->classname, classname ) )
+		{
+			// continuing an iteration, the previous entity is still in the class
+			num = entityClassNext[ entity->num() ];
+		}
+		else
+		{
+			int id = G_ClassnameId( classname, false );
+
+			if ( id < 0 )
+			{
+				return nullptr;
+			}
+
+			num = classFirst[ id ];
+
+			int first = entity ? entity->num() + 1 : skipClients ? MAX_CLIENTS : 0;
+
+			while ( num != -1 && num < first )
+			{
+				num = entityClassNext[ num ];
+			}
+		}
+
+		// the chain is sorted, nothing past num_entities can follow
+		for ( ; num != -1 && num < level.num_entities; num = entityClassNext[ num ] )
+		{
+			if ( G_EntityMatches( &g_entities[ num ], skipdisabled, fieldofs, match ) )
+			{
+				return &g_entities[ num ];
+			}
+		}
+
+		return nullptr;
+	}
 
 	if ( !entity )
 	{
 		entity = g_entities;
-		//start after the reserved player slots, if we are not searching for a player
-		if ( classname && !strcmp(classname, S_PLAYER_CLASSNAME) )
-			entity += MAX_CLIENTS;
 	}
 	else
 	{
@@ -328,24 +570,10 @@ gentity_t *G_IterateEntities( gentity_t *entity, const char *classname, bool ski
 
 	for ( ; entity < &g_entities[ level.num_entities ]; entity++ )
 	{
-		if ( !entity->inuse )
-			continue;
-
-		if( skipdisabled && !entity->enabled)
-			continue;
-
-
-		if ( classname && Q_stricmp( entity->classname, classname ) )
-			continue;
-
-		if ( fieldofs && match )
+		if ( G_EntityMatches( entity, skipdisabled, fieldofs, match ) )
 		{
-			fieldString = * ( char ** )( ( byte * ) entity + fieldofs );
-			if ( Q_stricmp( fieldString, match ) )
-				continue;
+			return entity;
 		}
-
-		return entity;
 	}
 
 	return nullptr;
@@ -420,6 +648,115 @@ void G_ForgetEntityId( Str::StringRef id )
 	}
 }
 
+/*
+=============
+Manage a mapping from entity names to the numbers of the entities using them,
+in entity number order. Entries are never removed, so that the resolved
+targets of mapEntity_t can keep pointing at them.
+=============
+*/
+
+static std::unordered_map<std::string, std::vector<int>> nameToEntityNumsMap;
+
+static const std::vector<int> *G_EntityNameList( const char *name )
+{
+	return &nameToEntityNumsMap[ G_NameKey( name ) ];
+}
+
+void G_RegisterEntityNames( gentity_t *entity )
+{
+	int entityNum = entity->num();
+
+	for ( const char *name : entity->mapEntity.names )
+	{
+		if ( !name )
+		{
+			continue;
+		}
+
+		std::vector<int> &list = nameToEntityNumsMap[ G_NameKey( name ) ];
+		auto it = std::lower_bound( list.begin(), list.end(), entityNum );
+
+		// aliases may repeat a name
+		if ( it == list.end() || *it != entityNum )
+		{
+			list.insert( it, entityNum );
+		}
+	}
+}
+
+void G_ForgetEntityNames( gentity_t *entity )
+{
+	int entityNum = entity->num();
+
+	for ( const char *name : entity->mapEntity.names )
+	{
+		if ( !name )
+		{
+			continue;
+		}
+
+		auto found = nameToEntityNumsMap.find( G_NameKey( name ) );
+
+		if ( found == nameToEntityNumsMap.end() )
+		{
+			continue;
+		}
+
+		std::vector<int> &list = found->second;
+		auto it = std::lower_bound( list.begin(), list.end(), entityNum );
+
+		if ( it != list.end() && *it == entityNum )
+		{
+			list.erase( it );
+		}
+	}
+}
+
+// the first in use entity of the list numbered above after, and enabled if asked so
+static gentity_t *G_NextNamedEntity( const std::vector<int> &list, int after, bool checkEnabled )
+{
+	for ( auto it = std::upper_bound( list.begin(), list.end(), after ); it != list.end(); ++it )
+	{
+		if ( *it >= level.num_entities )
+		{
+			break;
+		}
+
+		gentity_t *entity = &g_entities[ *it ];
+
+		if ( !entity->inuse || ( checkEnabled && !entity->enabled ) )
+		{
+			continue;
+		}
+
+		return entity;
+	}
+
+	return nullptr;
+}
+
+/*
+=============
+G_ResetEntityIndexes
+
+Empties the free slot list and the classname and name indexes, along with
+the reset of all the entities for a new game
+=============
+*/
+void G_ResetEntityIndexes()
+{
+	freeSlotFirst = -1;
+	freeSlotLast = -1;
+	std::fill( std::begin( freeSlotListed ), std::end( freeSlotListed ), false );
+
+	classnameIds.clear();
+	classFirst.clear();
+	std::fill( std::begin( entityClassId ), std::end( entityClassId ), 0 );
+
+	nameToEntityNumsMap.clear();
+}
+
 /*
 =============
 G_IterateEntitiesWithField
@@ -439,43 +776,67 @@ gentity_t *G_IterateEntitiesWithField( gentity_t *entity, size_t fieldofs, const
 	return G_IterateEntities( entity, nullptr, true, fieldofs, match );
 }
 
-// from quakestyle.telefragged.com
-// (NOBODY): Code helper function
-//
-gentity_t *G_IterateEntitiesWithinRadius( gentity_t *entity, const glm::vec3& origin, float radius )
+/**
+ * @brief Calls f for the linked entities whose bounding box center is within radius of origin,
+ *        in entity number order.
+ */
+void G_ForEntitiesInRadius( const glm::vec3& origin, float radius, const entityFilter_t& filter,
+                            const std::function<void( gentity_t * )>& f )
 {
-	if ( !entity )
+	// scratch space shared with the searches f may start, which work past
+	// the end of the entities of this one
+	static std::vector<int> touchlists;
+	vec3_t mins, maxs;
+	float  radiusSquared = Square( radius );
+	size_t first = touchlists.size();
+
+	for ( int i = 0; i < 3; i++ )
 	{
-		entity = g_entities;
-	}
-	else
-	{
-		entity++;
+		mins[ i ] = origin[ i ] - radius;
+		maxs[ i ] = origin[ i ] + radius;
 	}
 
-	for ( ; entity < &g_entities[ level.num_entities ]; entity++ )
+	// the center of an entity is within its bounds, so anything in range touches this box
+	touchlists.resize( first + MAX_GENTITIES );
+	int num = trap_EntitiesInBox( mins, maxs, touchlists.data() + first, MAX_GENTITIES );
+	touchlists.resize( first + num );
+
+	// keep the order of a linear scan
+	std::sort( touchlists.begin() + first, touchlists.end() );
+
+	for ( size_t i = first; i < first + num; i++ )
 	{
+		gentity_t *entity = &g_entities[ touchlists[ i ] ];
+
+		// f may have freed it
 		if ( !entity->inuse )
 		{
 			continue;
 		}
 
-		//TODO: (glm) remove temp copies when things will be vec3_t
-		//  will only remains in bad memories
-		glm::vec3 currentOrigin = VEC2GLM( entity->r.currentOrigin );
-		glm::vec3 mins = VEC2GLM( entity->r.mins );
-		glm::vec3 maxs = VEC2GLM( entity->r.maxs );
-		glm::vec3 eorg = origin - ( currentOrigin + ( mins + maxs ) * 0.5f );
+		if ( filter.eTypes && !( unsigned( entity->s.eType ) < 32 && ( filter.eTypes & ( 1 << entity->s.eType ) ) ) )
+		{
+			continue;
+		}
 
-		if ( glm::length( eorg ) > radius )
+		if ( filter.team != -1 && G_Team( entity ) != filter.team )
 		{
 			continue;
 		}
 
-		return entity;
+		vec3_t center;
+		VectorAdd( entity->r.mins, entity->r.maxs, center );
+		VectorMA( entity->r.currentOrigin, 0.5f, center, center );
+
+		if ( DistanceSquared( center, GLM4READ( origin ) ) > radiusSquared )
+		{
+			continue;
+		}
+
+		f( entity );
 	}
 
-	return nullptr;
+	touchlists.resize( first );
 }
 
 gentity_t *G_PickRandomEntity( const char *classname, size_t fieldofs, const char *match )
@@ -621,59 +982,65 @@ gentity_t *G_ResolveEntityKeyword( gentity_t *self, char *keyword )
 
 gentity_t *G_IterateTargets(gentity_t *entity, int *targetIndex, gentity_t *self)
 {
-	gentity_t *possibleTarget = nullptr;
+	mapEntity_t &mapEntity = self->mapEntity;
 
-	if (entity)
-		goto cont;
+	if (!entity)
+		*targetIndex = 0;
 
-	for (*targetIndex = 0; self->mapEntity.targets[*targetIndex]; ++(*targetIndex))
+	for (; mapEntity.targets[*targetIndex]; ++(*targetIndex), entity = nullptr)
 	{
-		if(self->mapEntity.targets[*targetIndex][0] == '$')
+		const char *name = mapEntity.targets[*targetIndex];
+
+		if(name[0] == '$')
 		{
-			possibleTarget = G_ResolveEntityKeyword( self, self->mapEntity.targets[*targetIndex] );
+			// a keyword resolves to a single entity
+			if (entity)
+				continue;
+
+			gentity_t *possibleTarget = G_ResolveEntityKeyword( self, mapEntity.targets[*targetIndex] );
 			if(possibleTarget && possibleTarget->enabled)
 				return possibleTarget;
 			return nullptr;
 		}
 
-		for( entity = &g_entities[ MAX_CLIENTS ]; entity < &g_entities[ level.num_entities ]; entity++ )
-		{
-			if ( !entity->inuse || !entity->enabled)
-				continue;
-
-			if ( matchesName( entity->mapEntity, self->mapEntity.targets[*targetIndex] ) )
-			{
-				return entity;
-			}
+		if (!mapEntity.targetEntities[*targetIndex])
+			mapEntity.targetEntities[*targetIndex] = G_EntityNameList( name );
 
-			cont: ;
-		}
+		gentity_t *next = G_NextNamedEntity( *mapEntity.targetEntities[*targetIndex],
+		                                     entity ? entity->num() : MAX_CLIENTS - 1, true );
+		if (next)
+			return next;
 	}
 	return nullptr;
 }
 
 gentity_t *G_IterateCallEndpoints(gentity_t *entity, int *calltargetIndex, gentity_t *self)
 {
-	if (entity)
-		goto cont;
+	mapEntity_t &mapEntity = self->mapEntity;
 
-	for (*calltargetIndex = 0; self->mapEntity.calltargets[*calltargetIndex].name; ++(*calltargetIndex))
+	if (!entity)
+		*calltargetIndex = 0;
+
+	for (; mapEntity.calltargets[*calltargetIndex].name; ++(*calltargetIndex), entity = nullptr)
 	{
-		if(self->mapEntity.calltargets[*calltargetIndex].name[0] == '$')
-			return G_ResolveEntityKeyword( self, self->mapEntity.calltargets[*calltargetIndex].name );
+		const char *name = mapEntity.calltargets[*calltargetIndex].name;
 
-		for( entity = &g_entities[ MAX_CLIENTS ]; entity < &g_entities[ level.num_entities ]; entity++ )
+		if(name[0] == '$')
 		{
-			if ( !entity->inuse )
+			// a keyword resolves to a single entity
+			if (entity)
 				continue;
 
-			if ( matchesName( entity->mapEntity, self->mapEntity.calltargets[*calltargetIndex].name ) )
-			{
-				return entity;
-			}
-
-			cont: ;
+			return G_ResolveEntityKeyword( self, mapEntity.calltargets[*calltargetIndex].name );
 		}
+
+		if (!mapEntity.callTargetEntities[*calltargetIndex])
+			mapEntity.callTargetEntities[*calltargetIndex] = G_EntityNameList( name );
+
+		gentity_t *next = G_NextNamedEntity( *mapEntity.callTargetEntities[*calltargetIndex],
+		                                     entity ? entity->num() : MAX_CLIENTS - 1, false );
+		if (next)
+			return next;
 	}
 	return nullptr;
 }
@@ -38,6 +38,8 @@ Maryland 20850 USA.
 
 #include "sg_map_entity.h"
 
+#include <functional>
+
 // gentity->flags
 #define FL_GODMODE                 0x00000010
 #define FL_NOTARGET                0x00000020
@@ -127,6 +129,13 @@ struct gentityCall_t
 	gentity_t *activator;
 };
 
+// filter for G_ForEntitiesInRadius, the default one accepts everything
+struct entityFilter_t
+{
+	int team = -1;   // only entities for which G_Team() returns this, -1 for any team
+	int eTypes = 0;  // bitmask of ( 1 << eType ) to accept, 0 for any type
+};
+
 //
 // g_entities.c
 //
@@ -136,23 +145,27 @@ void       G_InitGentity( gentity_t *e );
 gentity_t  *G_NewEntity( initEntityStyle_t style );
 gentity_t  *G_NewTempEntity( glm::vec3 origin, int event );
 void       G_FreeEntity( gentity_t *e );
+void       G_ResetEntityIndexes();
 
 //debug
 std::string etos( const gentity_t *entity );
 void       G_PrintEntityNameList( gentity_t *entity );
 
 //search, select, iterate
+void       G_SetClassname( gentity_t *entity, const char *classname );
 gentity_t  *G_IterateEntities( gentity_t *entity, const char *classname, bool skipdisabled, size_t fieldofs, const char *match );
 gentity_t  *G_IterateEntities( gentity_t *entity );
 gentity_t  *G_IterateEntitiesOfClass( gentity_t *entity, const char *classname );
 gentity_t  *G_IterateEntitiesWithField( gentity_t *entity, size_t fieldofs, const char *match );
-gentity_t  *G_IterateEntitiesWithinRadius( gentity_t *entity, const glm::vec3& origin, float radius );
+void       G_ForEntitiesInRadius( const glm::vec3& origin, float radius, const entityFilter_t& filter, const std::function<void( gentity_t * )>& f );
 gentity_t  *G_PickRandomEntity( const char *classname, size_t fieldofs, const char *match );
 gentity_t  *G_PickRandomEntityOfClass( const char *classname );
 gentity_t  *G_PickRandomEntityWithField( size_t fieldofs, const char *match );
 
 void G_RegisterEntityId( int entityNum, Str::StringRef id );
 void G_ForgetEntityId( Str::StringRef id );
+void G_RegisterEntityNames( gentity_t *entity );
+void G_ForgetEntityNames( gentity_t *entity );
 int G_IdToEntityNum( Str::StringRef id );
 
 void G_GetEntityOrigin( const gentity_t* entity, vec3_t origin );
@@ -29,6 +29,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #include "shared/parse.h"
 #include "Entities.h"
 #include "CBSE.h"
+#include "FrameProfile.h"
 #include "backend/CBSEBackend.h"
 #include "botlib/bot_api.h"
 #include "common/FileSystem.h"
@@ -70,6 +71,10 @@ Cvar::Cvar<bool> g_doWarmup("g_doWarmup", "whether to enable warmup period (g_wa
 Cvar::Cvar<bool> g_lockTeamsAtStart("g_lockTeamsAtStart", "(internal use) lock teams at start of match", Cvar::NONE, false);
 Cvar::Cvar<std::string> g_logFile("g_logFile", "sgame log file, relative to <homepath>/game/", Cvar::NONE, "games.log");
 Cvar::Cvar<int> g_logGameplayStatsFrequency("g_logGameplayStatsFrequency", "log gameplay stats every x seconds", Cvar::NONE, 10);
+static Cvar::Cvar<bool> g_traceProfile("g_traceProfile", "record per call site statistics of traces, see trace_stats", Cvar::NONE, false);
+static Cvar::Cvar<int> g_traceProfileLogInterval("g_traceProfileLogInterval", "log the trace statistics every x seconds (0 = never)", Cvar::NONE, 0);
+static Cvar::Cvar<bool> g_frameProfile("g_frameProfile", "record a timeline of the server frame phases, see profile_dump", Cvar::NONE, false);
+static Cvar::Cvar<bool> g_debugNetCode("g_debugNetCode", "rebuild the netcode of entities not marked dirty and warn on mismatch", Cvar::NONE, false);
 Cvar::Cvar<bool> g_logFileSync("g_logFileSync", "flush g_logFile on every write", Cvar::NONE, false);
 Cvar::Cvar<bool> g_allowVote("g_allowVote", "whether votes of any kind are allowed", Cvar::NONE, true);
 Cvar::Cvar<int> g_voteLimit("g_voteLimit", "max votes per player per round", Cvar::NONE, 5);
@@ -392,6 +397,9 @@ static void G_FindEntityGroups()
 				comparedEntity->flags |= FL_GROUPSLAVE;
 
 				// make sure that targets only point at the master
+				G_ForgetEntityNames( masterEntity );
+				G_ForgetEntityNames( comparedEntity );
+
 				for (int k = 0; comparedEntity->mapEntity.names[k]; k++)
 				{
 					if ( masterEntity->mapEntity.names[k] ) {
@@ -401,6 +409,9 @@ static void G_FindEntityGroups()
 					masterEntity->mapEntity.names[k] = comparedEntity->mapEntity.names[k];
 					comparedEntity->mapEntity.names[k] = nullptr;
 				}
+
+				G_RegisterEntityNames( masterEntity );
+				G_RegisterEntityNames( comparedEntity );
 			}
 		}
 	}
@@ -567,6 +578,7 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 	{
 		g_entities[i] = {};
 	}
+	G_ResetEntityIndexes();
 	level.gentities = g_entities;
 
 	// initialize special entities
@@ -593,7 +605,7 @@ void G_InitGame( int levelTime, int randomSeed, bool inClient )
 
 	for( int i = 0; i < MAX_CLIENTS; i++ )
 	{
-		g_entities[ i ].classname = BG_strdup( "clientslot" );
+		G_SetClassname( &g_entities[ i ], "clientslot" );
 	}
 
 	// let the server system know where the entites are
@@ -2179,6 +2191,44 @@ static void G_EvaluateAcceleration( gentity_t *ent, int msec )
 	VectorCopy( ent->acceleration, ent->oldAccel );
 }
 
+/*
+================
+G_ProfileEntityBranch
+
+Names the branch of the entity loop of G_RunFrame the entity takes, for the
+frame profile.
+================
+*/
+static const char *G_ProfileEntityBranch( const gentity_t *ent, int num )
+{
+	switch ( ent->s.eType )
+	{
+		case entityType_t::ET_BUILDABLE:
+			return "buildable";
+
+		case entityType_t::ET_CORPSE:
+			return "corpse";
+
+		case entityType_t::ET_MOVER:
+			return "mover";
+
+		case entityType_t::ET_MISSILE:
+			return "missile";
+
+		default:
+			if ( ent->physicsObject )
+			{
+				return "physics";
+			}
+			else if ( num < MAX_CLIENTS )
+			{
+				return "client";
+			}
+
+			return "think";
+	}
+}
+
 /*
 ================
 G_RunFrame
@@ -2259,6 +2309,14 @@ void G_RunFrame( int levelTime )
 
 	msec = level.time - level.previousTime;
 
+	TraceProfile::Frame( level.time, g_traceProfile.Get(), g_traceProfileLogInterval.Get() );
+	FrameProfile::Frame( g_frameProfile.Get() );
+
+	FRAME_PROFILE_SCOPE( "G_RunFrame" );
+
+	G_BotPerceptionFrame();
+	G_BotScheduleFrame();
+
 	// generate public-key messages
 	G_admin_pubkey();
 
@@ -2304,6 +2362,8 @@ void G_RunFrame( int levelTime )
 		// calculate the acceleration of this entity
 		if ( ent->evaluateAcceleration ) G_EvaluateAcceleration( ent, msec );
 
+		FrameProfile::Scope entityScope( G_ProfileEntityBranch( ent, i ), i );
+
 		// think/run entity by type
 		switch ( ent->s.eType )
 		{
@@ -2367,29 +2427,56 @@ void G_RunFrame( int levelTime )
 	{
 		if ( ent->inuse )
 		{
+			FrameProfile::Scope clientScope( "ClientEndFrame", i );
 			ClientEndFrame( ent );
 		}
 	}
 
 	// save position information for all active clients
-	G_UnlaggedStore();
+	{
+		FRAME_PROFILE_SCOPE( "G_UnlaggedStore" );
+		G_UnlaggedStore();
+	}
+
+	{
+		FRAME_PROFILE_SCOPE( "buildpoints" );
+
+		// Check if a build point can be removed from the queue.
+		G_RecoverBuildPoints();
 
-	// Check if a build point can be removed from the queue.
-	G_RecoverBuildPoints();
+		// Power down buildables if there is a budget deficit.
+		G_UpdateBuildablePowerStates();
 
-	// Power down buildables if there is a budget deficit.
-	G_UpdateBuildablePowerStates();
+		G_AnnounceStolenBP();
+	}
 
-	G_AnnounceStolenBP();
+	{
+		FRAME_PROFILE_SCOPE( "momentum" );
+		G_DecreaseMomentum();
+	}
 
-	G_DecreaseMomentum();
 	G_CalculateAvgPlayers();
-	G_SpawnClients( TEAM_ALIENS );
-	G_SpawnClients( TEAM_HUMANS );
-	G_UpdateZaps( msec );
-	Beacon::Frame( );
 
-	G_PrepareEntityNetCode();
+	{
+		FRAME_PROFILE_SCOPE( "G_SpawnClients" );
+		G_SpawnClients( TEAM_ALIENS );
+		G_SpawnClients( TEAM_HUMANS );
+	}
+
+	{
+		FRAME_PROFILE_SCOPE( "G_UpdateZaps" );
+		G_UpdateZaps( msec );
+	}
+
+	{
+		FRAME_PROFILE_SCOPE( "Beacon::Frame" );
+		Beacon::Frame( );
+	}
+
+	{
+		FRAME_PROFILE_SCOPE( "G_PrepareEntityNetCode" );
+		G_PrepareEntityNetCode();
+	}
 
 	// log gameplay statistics
 	G_LogGameplayStats( LOG_GAMEPLAY_STATS_BODY );
@@ -2397,8 +2484,15 @@ void G_RunFrame( int levelTime )
 	// see if it is time to end the level
 	CheckExitRules();
 
-	G_BotBackgroundNavgen();
-	G_BotFill( false );
+	{
+		FRAME_PROFILE_SCOPE( "G_BotBackgroundNavgen" );
+		G_BotBackgroundNavgen();
+	}
+
+	{
+		FRAME_PROFILE_SCOPE( "G_BotFill" );
+		G_BotFill( false );
+	}
 
 	// update to team status?
 	CheckTeamStatus();
@@ -2410,11 +2504,54 @@ void G_RunFrame( int levelTime )
 	}
 
 	BotDebugDrawMesh();
-	G_BotUpdateObstacles();
+
+	{
+		FRAME_PROFILE_SCOPE( "G_BotUpdateObstacles" );
+		G_BotUpdateObstacles();
+	}
+
+	{
+		FRAME_PROFILE_SCOPE( "G_BotUpdateRouteQueue" );
+		G_BotUpdateRouteQueue();
+	}
 
 	level.numBuildablesEstimate = numBuildables;
 }
 
+/*
+================
+G_MarkNetCodeDirty
+
+Called by the components whenever state they transmit changes, so that the
+next G_PrepareEntityNetCode rebuilds the entity's network state.
+================
+*/
+void G_MarkNetCodeDirty( gentity_t *ent )
+{
+	ent->netCodeClean = false;
+}
+
+/*
+================
+G_CheckCleanNetCode
+
+Rebuilds the network state of an entity that was not marked dirty and reports
+if the result differs from what it already had.
+================
+*/
+static void G_CheckCleanNetCode( gentity_t *ent )
+{
+	entityState_t cached = ent->s;
+
+	ent->entity->PrepareNetCode();
+
+	if ( memcmp( &cached, &ent->s, sizeof( entityState_t ) ) )
+	{
+		Log::Warn( "netcode of clean entity %s changed when rebuilt, a component does not call G_MarkNetCodeDirty",
+		           etos( ent ) );
+	}
+}
+
 void G_PrepareEntityNetCode() {
 	// TODO: Allow ForEntities with empty template arguments.
 	gentity_t *oldEnt = &g_entities[0];
@@ -2424,6 +2561,17 @@ void G_PrepareEntityNetCode() {
 			if (oldEnt->entity->Get<SpectatorComponent>()) {
 				continue;
 			}
+
+			// Clients also transmit their player state, which is not tracked.
+			if (oldEnt->netCodeClean && !oldEnt->client) {
+				if (g_debugNetCode.Get()) {
+					G_CheckCleanNetCode(oldEnt);
+				}
+				continue;
+			}
+
+			// Mark clean first so that components can keep volatile state dirty.
+			oldEnt->netCodeClean = true;
 			oldEnt->entity->PrepareNetCode();
 		}
 	}
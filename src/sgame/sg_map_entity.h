@@ -226,6 +226,10 @@ struct mapEntity_t
 	int          callTargetCount;
 	gentityCallDefinition_t calltargets[ MAX_ENTITY_CALLTARGETS + 1 ];
 
+	// the entity name index lists of targets and calltargets, resolved on first use
+	const std::vector<int> *targetEntities[ MAX_ENTITY_TARGETS ];
+	const std::vector<int> *callTargetEntities[ MAX_ENTITY_CALLTARGETS ];
+
 	//sound index, used by movers as well as target_speaker e.g. for looping sounds
 	int          soundIndex;
 
@@ -184,8 +184,6 @@ static int ImpactGrenade( gentity_t *ent, const trace2_t *trace, gentity_t * )
 
 static int ImpactFlamer( gentity_t *ent, const trace2_t *trace, gentity_t *hitEnt )
 {
-	gentity_t *neighbor = nullptr;
-
 	// ignite on direct hit
 	if ( random() < FLAMER_IGNITE_CHANCE )
 	{
@@ -193,19 +191,18 @@ static int ImpactFlamer( gentity_t *ent, const trace2_t *trace, gentity_t *hitEn
 	}
 
 	// ignite in radius
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, VEC2GLM( trace->endpos ), FLAMER_IGNITE_RADIUS ) ) )
-	{
+	G_ForEntitiesInRadius( VEC2GLM( trace->endpos ), FLAMER_IGNITE_RADIUS, {}, [&]( gentity_t *neighbor ) {
 		// we already handled other, since it might not always be in FLAMER_IGNITE_RADIUS due to BBOX sizes
 		if ( neighbor == hitEnt )
 		{
-			continue;
+			return;
 		}
 
 		if ( random() < FLAMER_IGNITE_SPLCHANCE )
 		{
 			neighbor->entity->Ignite( ent->parent );
 		}
-	}
+	} );
 
 	// set the environment on fire
 	if ( hitEnt->num() == ENTITYNUM_WORLD )
@@ -262,11 +259,9 @@ static int ImpactSlowblob( gentity_t *ent, const trace2_t *trace, gentity_t *hit
 	}
 
 	// put out fires in range
-	gentity_t *neighbor = nullptr;
 	// TODO: Iterate over all ignitable entities only
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, VEC2GLM( trace->endpos ),
-							    g_abuild_blobFireExtinguishRange.Get() ) ) )
-	{
+	G_ForEntitiesInRadius( VEC2GLM( trace->endpos ), g_abuild_blobFireExtinguishRange.Get(), {},
+	                       [&]( gentity_t *neighbor ) {
 		// extinguish other entity on fire nearby,
 		// and fires on ground
 		if ( neighbor != hitEnt && G_IsOnFire( neighbor ) )
@@ -274,7 +269,7 @@ static int ImpactSlowblob( gentity_t *ent, const trace2_t *trace, gentity_t *hit
 			++reward;
 			neighbor->entity->Extinguish( g_abuild_blobFireImmunityDuration.Get() );
 		}
-	}
+	} );
 
 	if ( reward )
 	{
@@ -451,7 +446,7 @@ void G_SetUpMissile( gentity_t *m, gentity_t *parent, const vec3_t start, const
 
 	// from attribute config file
 	m->s.weapon            = ma->number;
-	m->classname           = BG_strdup( ma->name );
+	G_SetClassname( m, ma->name );
 	m->clipmask            = ma->clipmask;
 	BG_MissileBounds( ma, m->r.mins, m->r.maxs );
 	m->s.eFlags            = ma->flags;
@@ -517,19 +512,23 @@ gentity_t *G_SpawnFire( const vec3_t origin, const vec3_t normal, gentity_t *fir
 	}
 
 	// don't spawn a fire inside another fire
-	fire = nullptr;
-	while ( ( fire = G_IterateEntitiesWithinRadius( fire, VEC2GLM( origin ), FIRE_MIN_DISTANCE ) ) )
+	entityFilter_t fires;
+	fires.eTypes = 1 << entityType_t::ET_FIRE;
+	bool nearFire = false;
+
+	G_ForEntitiesInRadius( VEC2GLM( origin ), FIRE_MIN_DISTANCE, fires, [&]( gentity_t * ) {
+		nearFire = true;
+	} );
+
+	if ( nearFire )
 	{
-		if ( fire->s.eType == entityType_t::ET_FIRE )
-		{
-			return nullptr;
-		}
+		return nullptr;
 	}
 
 	fire = G_NewEntity( HAS_CBSE );
 
 	// create a fire entity
-	fire->classname = BG_strdup( "fire" );
+	G_SetClassname( fire, "fire" );
 	fire->s.eType   = entityType_t::ET_FIRE;
 	fire->clipmask  = 0;
 
@@ -31,7 +31,8 @@ struct trace2_t;
 void              G_UnlaggedStore();
 void              G_UnlaggedClear( gentity_t *ent );
 void              G_UnlaggedCalc( int time, gentity_t *skipEnt );
-void              G_UnlaggedOn( gentity_t *attacker, const vec3_t muzzle, float range );
+void              G_UnlaggedOn( gentity_t *attacker, const vec3_t start, const vec3_t end, float radius );
+void              G_UnlaggedExclude( gentity_t *ent );
 void              G_UnlaggedOff();
 void              ClientThink( int clientNum );
 void              ClientEndFrame( gentity_t *ent );
@@ -61,6 +62,7 @@ namespace Beacon
 	void RemoveOrphaned( int clientNum );
 	bool EntityTaggable( int num, team_t team, bool trace );
 	gentity_t *TagTrace( glm::vec3 const& begin, glm::vec3 const& end, int skip, int mask, team_t team, bool refreshTagged );
+	float TagTraceRadius( float distance );
 	void Tag( gentity_t *ent, team_t team, bool permanent );
 	void Tag( gentity_t *ent, team_t team, bool permanent, int scoreDelta );
 	void UpdateTags( gentity_t *ent );
@@ -70,6 +72,9 @@ namespace Beacon
 
 // sg_buildable.c
 bool              G_IsWarnableMOD(meansOfDeath_t mod);
+void              G_IndexBuildable(gentity_t *ent);
+void              G_UnindexBuildable(gentity_t *ent);
+const std::vector<gentity_t*> &G_BuildablesOfType(buildable_t buildable);
 gentity_t         *G_Overmind();
 gentity_t         *G_ActiveOvermind();
 gentity_t         *G_Reactor();
@@ -232,6 +237,7 @@ void              G_ShutdownGame( int restart );
 void              G_CheckPmoveParamChanges();
 void              G_SendClientPmoveParams(int client);
 void              G_PrepareEntityNetCode();
+void              G_MarkNetCodeDirty( gentity_t *ent );
 Str::StringRef G_NextMapCommand();
 
 // sg_maprotation.c
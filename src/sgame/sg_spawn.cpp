@@ -458,7 +458,7 @@ static bool G_HandleEntityVersions( entityClassDescriptor_t *spawnDescription, g
 			Log::Warn("Entity %s uses a deprecated classtype — use the class ^5%s^* instead", etos( entity ), spawnDescription->replacement );
 		}
 	}
-	entity->classname = BG_strdup( spawnDescription->replacement );
+	G_SetClassname( entity, spawnDescription->replacement );
 	return true;
 }
 
@@ -691,6 +691,12 @@ static void G_ParseField( const char *key, const char *rawString, gentity_t *ent
 	switch ( fieldDescriptor->type )
 	{
 		case F_STRING:
+			if ( entityDataField == ( byte * ) &entity->classname )
+			{
+				G_SetClassname( entity, rawString ); // keeps the classname index up to date
+				break;
+			}
+
 			* ( char ** ) entityDataField = G_NewString( rawString );
 			break;
 
@@ -861,6 +867,8 @@ static void G_SpawnGEntityFromSpawnVars()
 	                       std::end( spawningEntity->mapEntity.targets ),
 	                       []( char *p ) { return p != nullptr; } );
 
+	G_RegisterEntityNames( spawningEntity );
+
 	/*
 	 * for backward compatbility, since before targets were used for calling,
 	 * we'll have to copy them over to the called-targets as well for now
@@ -1140,11 +1148,11 @@ static void SP_worldspawn()
 
 	g_entities[ ENTITYNUM_WORLD ].s.number = ENTITYNUM_WORLD;
 	g_entities[ ENTITYNUM_WORLD ].r.ownerNum = ENTITYNUM_NONE;
-	g_entities[ ENTITYNUM_WORLD ].classname = BG_strdup( S_WORLDSPAWN );
+	G_SetClassname( &g_entities[ ENTITYNUM_WORLD ], S_WORLDSPAWN );
 
 	g_entities[ ENTITYNUM_NONE ].s.number = ENTITYNUM_NONE;
 	g_entities[ ENTITYNUM_NONE ].r.ownerNum = ENTITYNUM_NONE;
-	g_entities[ ENTITYNUM_NONE ].classname = BG_strdup( "nothing" );
+	G_SetClassname( &g_entities[ ENTITYNUM_NONE ], "nothing" );
 
 	// see if we want a warmup time
 	trap_SetConfigstring( CS_WARMUP, "-1" );
@@ -120,6 +120,9 @@ struct gentity_t
 	// New style entity
 	Entity* entity;
 
+	// whether s is up to date with the components, see G_PrepareEntityNetCode
+	bool netCodeClean;
+
 	char *classname; //used by buildables & other spawned at start of map
 	mapEntity_t mapEntity; // fields only used by BSP entities (not counting layout buildables)
 
@@ -392,6 +395,21 @@ struct unlagged_t
 };
 
 #define MAX_UNLAGGED_MARKERS 256
+
+// positions and bounds of all the clients at each of the last frames, one
+// array per component so that culling the clients against a shot only
+// streams through the data it needs, see G_UnlaggedOn
+struct unlaggedHistory_t
+{
+	int   index; // marker of the most recent frame
+	int   times[ MAX_UNLAGGED_MARKERS ];
+	float origin[ MAX_UNLAGGED_MARKERS ][ 3 ][ MAX_CLIENTS ];
+	float mins[ MAX_UNLAGGED_MARKERS ][ 3 ][ MAX_CLIENTS ];
+	float maxs[ MAX_UNLAGGED_MARKERS ][ 3 ][ MAX_CLIENTS ];
+	float radius[ MAX_UNLAGGED_MARKERS ][ MAX_CLIENTS ]; // of the bounds around origin
+	bool  used[ MAX_UNLAGGED_MARKERS ][ MAX_CLIENTS ];
+};
+
 #define MAX_TRAMPLE_BUILDABLES_TRACKED 20
 
 /**
@@ -456,7 +474,6 @@ struct gclient_t
 	int        lastFuelRefillTime;
 	int        lastLockWarnTime; // used for the entity locking system
 
-	unlagged_t unlaggedHist[ MAX_UNLAGGED_MARKERS ];
 	unlagged_t unlaggedBackup;
 	unlagged_t unlaggedCalc;
 	int        unlaggedTime;
@@ -611,8 +628,7 @@ struct level_locals_t
 
 	int              pausedTime;
 
-	int              unlaggedIndex;
-	int              unlaggedTimes[ MAX_UNLAGGED_MARKERS ];
+	unlaggedHistory_t unlagged;
 
 	char             layout[ MAX_QPATH ];
 
@@ -39,8 +39,13 @@ Maryland 20850 USA.
 
 #include "common/Common.h"
 #include "sg_local.h"
+#include "sg_cm_world.h"
+#include "CBSE.h"
+#include "FrameProfile.h"
 #include "botlib/bot_api.h"
 
+#include <random>
+
 #define IS_NON_NULL_VEC3(vec3tor) (vec3tor[0] || vec3tor[1] || vec3tor[2])
 
 class TraceCmd : public Cmd::StaticCmd
@@ -106,6 +111,216 @@ public:
 };
 static ShowBehaviorCmd showBehaviorRegistration;
 
+class BehaviorProfileCmd : public Cmd::StaticCmd
+{
+public:
+	BehaviorProfileCmd() : StaticCmd( "behavior_profile", 0, "print how often the nodes of a bot behavior tree ran (see g_bot_behaviorProfile)" ) {}
+	void Run( const Cmd::Args& args ) const override
+	{
+		if ( args.Argc() < 2 || args.Argc() > 3 || ( args.Argc() == 3 && args.Argv( 2 ) != "reset" ) )
+		{
+			PrintUsage( args, "<behavior> [reset]" );
+			return;
+		}
+
+		std::string str = G_BotBehaviorProfile( args.Argv( 1 ), args.Argc() == 3 );
+		if ( str.empty() )
+		{
+			Print( "behavior `%s` does not exist", args.Argv( 1 ) );
+		}
+		else
+		{
+			Print( str );
+		}
+	}
+};
+static BehaviorProfileCmd behaviorProfileRegistration;
+
+class RouteStatsCmd : public Cmd::StaticCmd
+{
+public:
+	RouteStatsCmd() : StaticCmd( "route_stats", 0, "print the hit rate of the bots' shared route cache (see g_bot_routeCacheSize)" ) {}
+	void Run( const Cmd::Args& args ) const override
+	{
+		bool reset = args.Argc() > 1 && args.Argv( 1 ) == "reset";
+		std::string str = G_BotRouteCacheStats( reset );
+
+		if ( !reset )
+		{
+			Print( str );
+		}
+	}
+};
+static RouteStatsCmd routeStatsRegistration;
+
+class BotBudgetStatsCmd : public Cmd::StaticCmd
+{
+public:
+	BotBudgetStatsCmd() : StaticCmd( "bot_budget_stats", 0, "print how often the bots overran their think budget (see g_bot_thinkBudget)" ) {}
+	void Run( const Cmd::Args& args ) const override
+	{
+		bool reset = args.Argc() > 1 && args.Argv( 1 ) == "reset";
+		std::string str = G_BotThinkBudgetStats( reset );
+
+		if ( !reset )
+		{
+			Print( str );
+		}
+	}
+};
+static BotBudgetStatsCmd botBudgetStatsRegistration;
+
+class TraceStatsCmd : public Cmd::StaticCmd
+{
+public:
+	TraceStatsCmd() : StaticCmd( "trace_stats", 0, "print per call site statistics of traces (see g_traceProfile)" ) {}
+	void Run( const Cmd::Args& args ) const override
+	{
+		if ( args.Argc() > 1 && args.Argv( 1 ) == "reset" )
+		{
+			TraceProfile::Reset();
+			return;
+		}
+
+		if ( !TraceProfile::enabled )
+		{
+			Print( "trace profiling is disabled, see g_traceProfile" );
+		}
+
+		Print( TraceProfile::Report( 50 ) );
+	}
+};
+static TraceStatsCmd traceStatsRegistration;
+
+class ProfileDumpCmd : public Cmd::StaticCmd
+{
+public:
+	ProfileDumpCmd() : StaticCmd( "profile_dump", 0, "write the recorded server frames as a Chrome trace (see g_frameProfile)" ) {}
+	void Run( const Cmd::Args& args ) const override
+	{
+		if ( args.Argc() != 2 )
+		{
+			PrintUsage( args, "<file>" );
+			return;
+		}
+
+		if ( !FrameProfile::NumEvents() )
+		{
+			Print( "nothing was recorded, see g_frameProfile" );
+			return;
+		}
+
+		std::string json = FrameProfile::ChromeTrace();
+		const std::string &fileName = args.Argv( 1 );
+		fileHandle_t f;
+
+		if ( trap_FS_FOpenFile( fileName.c_str(), &f, fsMode_t::FS_WRITE ) < 0 )
+		{
+			Print( "could not open %s", fileName );
+			return;
+		}
+
+		trap_FS_Write( json.data(), json.size(), f );
+		trap_FS_FCloseFile( f );
+
+		Print( "wrote %d spans to %s", FrameProfile::NumEvents(), fileName );
+	}
+};
+static ProfileDumpCmd profileDumpRegistration;
+
+#ifdef SGAME_BENCHMARK
+// Compares walking a CBSE component pool with walking the ordered set of
+// pointers that was used before, for instances scattered like components
+// living inside their entities are. Only in the sgame built for the
+// benchmark, see BUILD_SGAME_BENCHMARK.
+class CbseBenchmarkCmd : public Cmd::StaticCmd
+{
+public:
+	CbseBenchmarkCmd() : StaticCmd( "cbse_benchmark", 0, "time iterating component pools against ordered sets" ) {}
+	void Run( const Cmd::Args& ) const override
+	{
+		struct benchComponent_t
+		{
+			int poolSlot;
+			int value;
+			char entityPadding[ 1024 ];
+		};
+
+		constexpr int rounds = 200;
+		std::mt19937 rng( 1 );
+
+		for ( int count : { 1024, 4096 } )
+		{
+			std::vector<std::unique_ptr<benchComponent_t>> instances;
+			std::vector<std::unique_ptr<char[]>> garbage;
+			std::set<benchComponent_t*> set;
+			ComponentPool<benchComponent_t> pool;
+
+			// Interleave allocations of other sizes, like the rest of the
+			// entities and the game state, so that the instances do not end
+			// up next to each other in the heap.
+			for ( int i = 0; i < count; i++ )
+			{
+				garbage.emplace_back( new char[ std::uniform_int_distribution<int>( 16, 8192 )( rng ) ] );
+				instances.emplace_back( new benchComponent_t() );
+			}
+
+			garbage.clear();
+
+			// Entities are not spawned in the order of their addresses.
+			std::shuffle( instances.begin(), instances.end(), rng );
+
+			for ( int i = 0; i < count; i++ )
+			{
+				benchComponent_t *component = instances[ i ].get();
+				component->value = i;
+				set.insert( component );
+				component->poolSlot = pool.Add( component );
+			}
+
+			int64_t setSum = 0;
+			auto start = std::chrono::steady_clock::now();
+
+			for ( int round = 0; round < rounds; round++ )
+			{
+				for ( benchComponent_t *component : set )
+				{
+					setSum += component->value;
+				}
+			}
+
+			auto setTime = std::chrono::steady_clock::now() - start;
+
+			int64_t poolSum = 0;
+			start = std::chrono::steady_clock::now();
+
+			for ( int round = 0; round < rounds; round++ )
+			{
+				ComponentPool<benchComponent_t>::Iteration iteration( pool );
+
+				for ( size_t slot = 0; slot < pool.Size(); slot++ )
+				{
+					if ( benchComponent_t *component = pool[ slot ] )
+					{
+						poolSum += component->value;
+					}
+				}
+			}
+
+			auto poolTime = std::chrono::steady_clock::now() - start;
+
+			auto perRound = []( std::chrono::steady_clock::duration time ) {
+				return std::chrono::duration<float, std::micro>( time ).count() / rounds;
+			};
+
+			Print( "%d components: set %.2fµs, pool %.2fµs per iteration%s", count,
+			       perRound( setTime ), perRound( poolTime ), setSum == poolSum ? "" : " (checksum mismatch)" );
+		}
+	}
+};
+static CbseBenchmarkCmd cbseBenchmarkRegistration;
+#endif
+
 static void Svcmd_EntityFire_f()
 {
 	char argument[ MAX_STRING_CHARS ];
@@ -842,6 +1057,7 @@ static const struct svcmd
 	{ "printqueue",         false, Svcmd_PrintQueue_f           },
 	{ "say",                true,  Svcmd_MessageWrapper         },
 	{ "say_team",           true,  Svcmd_TeamMessage_f          },
+	{ "sectorlist",         false, G_CM_SectorList_f            },
 	{ "stopMapRotation",    false, G_StopMapRotation            },
 };
 
@@ -29,6 +29,7 @@ along with Unvanquished Source Code.  If not, see <http://www.gnu.org/licenses/>
 
 #include "shared/CommonProxies.h"
 #include "shared/server/sg_api.h"
+#include "shared/TraceProfile.h"
 
 struct gentity_t;
 
@@ -50,4 +51,9 @@ void             trap_SetBrushModel( gentity_t *ent, const char *name );
 bool         trap_InPVS( const vec3_t p1, const vec3_t p2 );
 bool         trap_InPVSIgnorePortals( const vec3_t p1, const vec3_t p2 );
 
+// attribute the queries to their call site, see TraceProfile.h
+// (the definitions use parenthesized names to escape these)
+#define trap_Trace( ... ) TRACE_PROFILE_CALL( trap_Trace( __VA_ARGS__ ) )
+#define trap_EntitiesInBox( ... ) TRACE_PROFILE_CALL( trap_EntitiesInBox( __VA_ARGS__ ) )
+
 #endif // SG_TRAPCALLS_H_
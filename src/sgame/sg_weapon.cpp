@@ -29,6 +29,7 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include "common/Common.h"
 #include "sg_local.h"
+#include "sg_cm_world.h"
 #include "Entities.h"
 #include "CBSE.h"
 
@@ -221,7 +222,6 @@ bool G_RefillFuel( gentity_t *self, bool triggerEvent )
  */
 bool G_FindAmmo( gentity_t *self )
 {
-	gentity_t *neighbor = nullptr;
 	bool  foundSource = false;
 
 	// don't search for a source if refilling isn't possible
@@ -231,13 +231,15 @@ bool G_FindAmmo( gentity_t *self )
 	}
 
 	// search for ammo source
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, VEC2GLM( self->s.origin ), ENTITY_USE_RANGE ) ) )
-	{
+	entityFilter_t buildables;
+	buildables.eTypes = 1 << entityType_t::ET_BUILDABLE;
+
+	G_ForEntitiesInRadius( VEC2GLM( self->s.origin ), ENTITY_USE_RANGE, buildables, [&]( gentity_t *neighbor ) {
 		// only friendly, living and powered buildables provide ammo
-		if ( neighbor->s.eType != entityType_t::ET_BUILDABLE || !G_OnSameTeam( self, neighbor ) ||
-		     !neighbor->spawned || !neighbor->powered || Entities::IsDead( neighbor ) )
+		if ( !G_OnSameTeam( self, neighbor ) || !neighbor->spawned || !neighbor->powered ||
+		     Entities::IsDead( neighbor ) )
 		{
-			continue;
+			return;
 		}
 
 		switch ( neighbor->s.modelindex )
@@ -254,7 +256,7 @@ bool G_FindAmmo( gentity_t *self )
 				}
 				break;
 		}
-	}
+	} );
 
 	if ( foundSource )
 	{
@@ -270,7 +272,6 @@ bool G_FindAmmo( gentity_t *self )
  */
 bool G_FindFuel( gentity_t *self )
 {
-	gentity_t *neighbor = nullptr;
 	bool  foundSource = false;
 
 	if ( !self || !self->client )
@@ -279,13 +280,15 @@ bool G_FindFuel( gentity_t *self )
 	}
 
 	// search for fuel source
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, VEC2GLM( self->s.origin ), ENTITY_USE_RANGE ) ) )
-	{
+	entityFilter_t buildables;
+	buildables.eTypes = 1 << entityType_t::ET_BUILDABLE;
+
+	G_ForEntitiesInRadius( VEC2GLM( self->s.origin ), ENTITY_USE_RANGE, buildables, [&]( gentity_t *neighbor ) {
 		// only friendly, living and powered buildables provide fuel
-		if ( neighbor->s.eType != entityType_t::ET_BUILDABLE || !G_OnSameTeam( self, neighbor ) ||
-		     !neighbor->spawned || !neighbor->powered || Entities::IsDead( neighbor ) )
+		if ( !G_OnSameTeam( self, neighbor ) || !neighbor->spawned || !neighbor->powered ||
+		     Entities::IsDead( neighbor ) )
 		{
-			continue;
+			return;
 		}
 
 		switch ( neighbor->s.modelindex )
@@ -294,7 +297,7 @@ bool G_FindFuel( gentity_t *self )
 				foundSource = true;
 				break;
 		}
-	}
+	} );
 
 	if ( foundSource )
 	{
@@ -333,12 +336,35 @@ static void G_WideTrace(
 	glm::vec3 mins = -maxs;
 	halfDiagonal = glm::length( maxs );
 
-	G_UnlaggedOn( ent, GLM4READ( muzzle ), range + halfDiagonal );
+	glm::vec3 reach = muzzle + range * forward;
+	G_UnlaggedOn( ent, GLM4READ( muzzle ), GLM4READ( reach ), halfDiagonal );
 
-	// Trace box against entities
-	glm::vec3 end;
-	VectorMA( muzzle, range, forward, end );
-	trap_Trace( tr, muzzle, mins, maxs, end, ent->s.number, CONTENTS_BODY, 0 );
+	glm::vec3 absDir = glm::max( glm::vec3( 1.0e-9f ), glm::abs( forward ) );
+	glm::vec3 elementwiseDistToSide = maxs / absDir;
+	// distToSide is the distance from the center of the trace box to the intersection of the trace line
+	// and a side of the box. Should be between min(width, height) and halfDiagonal
+	float distToSide = std::min({elementwiseDistToSide.x, elementwiseDistToSide.y, elementwiseDistToSide.z});
+
+	// Trace box against entities, and a line against the world over the longest range
+	// it could need, so both share the same entity candidates.
+	traceRequest_t requests[ 2 ] = {};
+	trace_t results[ 2 ];
+
+	VectorCopy( muzzle, requests[ 0 ].start );
+	VectorCopy( mins, requests[ 0 ].mins );
+	VectorCopy( maxs, requests[ 0 ].maxs );
+	VectorMA( muzzle, range, forward, requests[ 0 ].end );
+	requests[ 0 ].passEntityNum = ent->s.number;
+	requests[ 0 ].contentmask = CONTENTS_BODY;
+
+	VectorCopy( muzzle, requests[ 1 ].start );
+	VectorMA( muzzle, range + distToSide, forward, requests[ 1 ].end );
+	requests[ 1 ].passEntityNum = ent->s.number;
+	requests[ 1 ].contentmask = CONTENTS_SOLID;
+
+	G_CM_TraceBatch( requests, results, 2 );
+
+	*tr = results[ 0 ];
 
 	if ( tr->entityNum != ENTITYNUM_NONE )
 	{
@@ -348,14 +374,16 @@ static void G_WideTrace(
 	// Line trace against the world, so we never hit through obstacles.
 	// The range is reduced according to the former trace so we don't hit something behind the
 	// current target.
-	glm::vec3 absDir = glm::max( glm::vec3( 1.0e-9f ), glm::abs( forward ) );
-	glm::vec3 elementwiseDistToSide = maxs / absDir;
-	// distToSide is the distance from the center of the trace box to the intersection of the trace line
-	// and a side of the box. Should be between min(width, height) and halfDiagonal
-	float distToSide = std::min({elementwiseDistToSide.x, elementwiseDistToSide.y, elementwiseDistToSide.z});
 	float scale = tr->fraction * range + distToSide;
-	VectorMA( muzzle, scale, forward, end );
-	trap_Trace( tr, muzzle, {}, {}, end, ent->s.number, CONTENTS_SOLID, 0 );
+	*tr = results[ 1 ];
+
+	if ( tr->fraction * ( range + distToSide ) > scale )
+	{
+		// the line only hit something behind the reduced range
+		tr->fraction = 1.0f;
+		tr->entityNum = ENTITYNUM_NONE;
+		VectorMA( muzzle, scale, forward, tr->endpos );
+	}
 
 	// In case we hit a different target, which can happen if two potential targets are close,
 	// switch to it, so we will end up with the target we were looking at.
@@ -543,7 +571,7 @@ static void FireBullet( gentity_t *self, float spread, float damage, meansOfDeat
 	// don't use unlagged if this is not a client (e.g. turret)
 	if ( self->client )
 	{
-		G_UnlaggedOn( self, GLM4READ( muzzle ), 8192 * 16 );
+		G_UnlaggedOn( self, GLM4READ( muzzle ), GLM4READ( end ), 0.0f );
 		trap_Trace( &tr, muzzle, {}, {}, end, self->s.number, MASK_SHOT, 0 );
 		G_UnlaggedOff();
 	}
@@ -597,8 +625,11 @@ static void ShotgunPattern( glm::vec3 const& origin, glm::vec3 const& origin2, i
 	// FIXME: the cross product of forward and right is DOWN not up!
 	glm::vec3 up = glm::cross( forward, right );
 
+	traceRequest_t pellets[ SHOTGUN_PELLETS ] = {};
+	trace_t        results[ SHOTGUN_PELLETS ];
+
 	// generate the "random" spread pattern
-	for ( int i = 0; i < SHOTGUN_PELLETS; i++ )
+	for ( traceRequest_t &pellet : pellets )
 	{
 		float r = Q_crandom( &seed ) * M_PI;
 		float a = Q_random( &seed ) * SHOTGUN_SPREAD * 16;
@@ -610,10 +641,39 @@ static void ShotgunPattern( glm::vec3 const& origin, glm::vec3 const& origin2, i
 		end += r * right;
 		end += u * up;
 
-		trace_t tr;
-		trap_Trace( &tr, origin, glm::vec3(), glm::vec3(), end, self->s.number, MASK_SHOT, 0 );
-		g_entities[ tr.entityNum ].Damage( (float)SHOTGUN_DMG, self, VEC2GLM( tr.endpos ),
-		                                   forward, 0, MOD_SHOTGUN );
+		VectorCopy( origin, pellet.start );
+		VectorCopy( end, pellet.end );
+		pellet.passEntityNum = self->s.number;
+		pellet.contentmask = MASK_SHOT;
+	}
+
+	// all the pellets sweep the same cone, so trace them together; as when
+	// they were traced one by one, once a pellet changes what it hits (a kill
+	// turns the body into a corpse) the following ones are traced again
+	int first = 0;
+
+	while ( first < SHOTGUN_PELLETS )
+	{
+		G_CM_TraceBatch( pellets + first, results + first, SHOTGUN_PELLETS - first );
+
+		int i = first;
+		first = SHOTGUN_PELLETS;
+
+		for ( ; i < SHOTGUN_PELLETS; i++ )
+		{
+			gentity_t *target = &g_entities[ results[ i ].entityNum ];
+			int contents = target->r.contents;
+			bool linked = target->r.linked;
+
+			target->Damage( (float)SHOTGUN_DMG, self, VEC2GLM( results[ i ].endpos ),
+			                forward, 0, MOD_SHOTGUN );
+
+			if ( target->r.contents != contents || target->r.linked != linked )
+			{
+				first = i + 1;
+				break;
+			}
+		}
 	}
 }
 
@@ -633,7 +693,9 @@ static void FireShotgun( gentity_t *self ) //TODO merge with FireBullet
 	tent->s.otherEntityNum = self->s.number;
 
 	// calculate the pattern and do the damage
-	G_UnlaggedOn( self, GLM4READ( muzzle ), SHOTGUN_RANGE );
+	// the pellets spread up to SHOTGUN_SPREAD * 16 units around the aim at full range
+	glm::vec3 reach = muzzle + float( SHOTGUN_RANGE ) * forward;
+	G_UnlaggedOn( self, GLM4READ( muzzle ), GLM4READ( reach ), SHOTGUN_SPREAD * 16 );
 	ShotgunPattern( VEC2GLM( tent->s.pos.trBase ), VEC2GLM( tent->s.origin2 ), tent->s.eventParm, self );
 	G_UnlaggedOff();
 }
@@ -652,15 +714,16 @@ FIREBOMB
 void G_FirebombMissileIgnite( gentity_t *self )
 {
 	// ignite alien buildables in range
-	gentity_t *neighbor = nullptr;
-	while ( ( neighbor = G_IterateEntitiesWithinRadius( neighbor, VEC2GLM( self->s.origin ), FIREBOMB_IGNITE_RANGE ) ) )
-	{
-		if ( neighbor->s.eType == entityType_t::ET_BUILDABLE && G_Team( neighbor ) == TEAM_ALIENS &&
-		     G_LineOfSight( self, neighbor ) )
+	entityFilter_t alienBuildables;
+	alienBuildables.team = TEAM_ALIENS;
+	alienBuildables.eTypes = 1 << entityType_t::ET_BUILDABLE;
+
+	G_ForEntitiesInRadius( VEC2GLM( self->s.origin ), FIREBOMB_IGNITE_RANGE, alienBuildables, [&]( gentity_t *neighbor ) {
+		if ( G_LineOfSight( self, neighbor ) )
 		{
 			neighbor->entity->Ignite( self->parent );
 		}
-	}
+	} );
 
 	// set floor below on fire (assumes the firebomb lays on the floor!)
 	G_SpawnFire( self->s.origin, GLM4READ( glm::vec3( 0.f, 0.f, 1.f ) ), self->parent );
@@ -1091,7 +1154,7 @@ static void CreateNewZap( gentity_t *creator, const glm::vec3 &muzzle,
 
 		zap->effectChannel = G_NewEntity( NO_CBSE );
 		zap->effectChannel->s.eType = entityType_t::ET_LEV2_ZAP_CHAIN;
-		zap->effectChannel->classname = BG_strdup( "lev2zapchain" );
+		G_SetClassname( zap->effectChannel, "lev2zapchain" );
 		UpdateZapEffect( zap, muzzle );
 
 		return;
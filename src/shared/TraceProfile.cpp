@@ -0,0 +1,175 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+#include "TraceProfile.h"
+
+namespace TraceProfile {
+
+	static const char *const kindNames[] =
+	{
+		"trace",
+		"trace2",
+		"traceBatch",
+		"pointContents",
+		"areaEntities",
+	};
+
+	static_assert( ARRAY_LEN( kindNames ) == static_cast<size_t>( Kind::NUM_KINDS ), "kindNames" );
+
+	bool enabled = false;
+	Site *currentSite = nullptr;
+
+	static Site *sites = nullptr;
+	static Site unknownSite( "unknown", 0, "(untagged)" );
+	static int frames;
+	static int lastLogTime;
+
+	Site::Site( const char *file, int line, const char *function )
+		: file( file ), line( line ), function( function ), stats(), next( sites )
+	{
+		sites = this;
+	}
+
+	void Timer::Record( Kind kind, std::chrono::steady_clock::duration duration )
+	{
+		Site *site = currentSite ? currentSite : &unknownSite;
+		Stats &stats = site->stats[ static_cast<int>( kind ) ];
+		int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>( duration ).count();
+
+		int bucket = 0;
+
+		while ( bucket < NUM_BUCKETS - 1 && microseconds >= ( int64_t( 1 ) << bucket ) )
+		{
+			bucket++;
+		}
+
+		stats.frameCount++;
+		stats.count++;
+		stats.microseconds += microseconds;
+		stats.histogram[ bucket ]++;
+	}
+
+	void Reset()
+	{
+		for ( Site *site = sites; site; site = site->next )
+		{
+			for ( Stats &stats : site->stats )
+			{
+				stats = {};
+			}
+		}
+
+		frames = 0;
+	}
+
+	void Frame( int time, bool enable, int logInterval )
+	{
+		if ( enable != enabled )
+		{
+			enabled = enable;
+			lastLogTime = time;
+			Reset();
+		}
+
+		if ( !enabled )
+		{
+			return;
+		}
+
+		for ( Site *site = sites; site; site = site->next )
+		{
+			for ( Stats &stats : site->stats )
+			{
+				stats.lastFrameCount = stats.frameCount;
+				stats.maxFrameCount = std::max( stats.maxFrameCount, stats.frameCount );
+				stats.frameCount = 0;
+			}
+		}
+
+		frames++;
+
+		if ( logInterval > 0 && time - lastLogTime >= logInterval * 1000 )
+		{
+			lastLogTime = time;
+			Log::Notice( Report( 20 ) );
+		}
+	}
+
+	std::string Report( int maxSites )
+	{
+		struct entry_t
+		{
+			const Site  *site;
+			int         kind;
+		};
+
+		std::vector<entry_t> entries;
+
+		for ( const Site *site = sites; site; site = site->next )
+		{
+			for ( int kind = 0; kind < static_cast<int>( Kind::NUM_KINDS ); kind++ )
+			{
+				if ( site->stats[ kind ].count )
+				{
+					entries.push_back( { site, kind } );
+				}
+			}
+		}
+
+		std::sort( entries.begin(), entries.end(), []( const entry_t &a, const entry_t &b ) {
+			return a.site->stats[ a.kind ].microseconds > b.site->stats[ b.kind ].microseconds;
+		} );
+
+		std::string report = Str::Format( "trace stats over %d frames (histogram buckets: <1us, <2us, <4us ... >=%dus)",
+		                                  frames, 1 << ( NUM_BUCKETS - 2 ) );
+
+		int lines = 0;
+
+		for ( const entry_t &entry : entries )
+		{
+			if ( lines++ == maxSites )
+			{
+				report += Str::Format( "\n... %d more", int( entries.size() ) - maxSites );
+				break;
+			}
+
+			const Stats &stats = entry.site->stats[ entry.kind ];
+			std::string histogram;
+
+			for ( int count : stats.histogram )
+			{
+				histogram += Str::Format( " %d", count );
+			}
+
+			report += Str::Format( "\n%s:%d %s [%s] calls %d (%.1f/frame, last %d, max %d), total %.2fms, mean %.1fus, histogram%s",
+			                       entry.site->file, entry.site->line, entry.site->function, kindNames[ entry.kind ],
+			                       int( stats.count ), stats.count / float( std::max( frames, 1 ) ),
+			                       stats.lastFrameCount, stats.maxFrameCount,
+			                       stats.microseconds / 1000.0f, stats.microseconds / float( stats.count ),
+			                       histogram );
+		}
+
+		return report;
+	}
+}
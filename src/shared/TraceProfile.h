@@ -0,0 +1,163 @@
+/*
+===========================================================================
+
+Unvanquished GPL Source Code
+Copyright (C) 2026 Unvanquished Developers
+
+This file is part of the Unvanquished GPL Source Code (Unvanquished Source Code).
+
+Unvanquished is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Unvanquished is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Unvanquished. If not, see <http://www.gnu.org/licenses/>.
+
+===========================================================================
+*/
+
+// TraceProfile.h -- per call site statistics of the collision queries
+
+#ifndef SHARED_TRACE_PROFILE_H_
+#define SHARED_TRACE_PROFILE_H_
+
+#include "common/Common.h"
+
+#include <chrono>
+
+namespace TraceProfile {
+
+	enum class Kind
+	{
+		TRACE,
+		TRACE2,
+		TRACE_BATCH,
+		POINT_CONTENTS,
+		AREA_ENTITIES,
+		NUM_KINDS
+	};
+
+	// latency buckets are powers of two: [0, 1) [1, 2) [2, 4) ... microseconds
+	constexpr int NUM_BUCKETS = 12;
+
+	struct Stats
+	{
+		int     frameCount; // calls during the current frame
+		int     lastFrameCount;
+		int     maxFrameCount;
+		int64_t count;
+		int64_t microseconds;
+		int     histogram[ NUM_BUCKETS ];
+	};
+
+	/**
+	 * @brief A place in the code issuing collision queries. Sites are statics
+	 *        created by the TRACE_SITE macro and chain themselves on creation.
+	 */
+	struct Site
+	{
+		Site( const char *file, int line, const char *function );
+
+		const char *file;
+		int         line;
+		const char *function;
+		Stats       stats[ static_cast<int>( Kind::NUM_KINDS ) ];
+		Site        *next;
+	};
+
+	extern bool enabled;
+	extern Site *currentSite;
+
+	/**
+	 * @brief Attributes the queries made during its lifetime to the given site,
+	 *        unless an enclosing scope already did. The site is null while
+	 *        profiling is off, see TRACE_PROFILE_SITE.
+	 */
+	class SiteScope
+	{
+	public:
+		explicit SiteScope( Site *site ) : set_( site && !currentSite )
+		{
+			if ( set_ )
+			{
+				currentSite = site;
+			}
+		}
+
+		~SiteScope()
+		{
+			if ( set_ )
+			{
+				currentSite = nullptr;
+			}
+		}
+
+	private:
+		bool set_;
+	};
+
+	/**
+	 * @brief Counts and times one query of the current site.
+	 */
+	class Timer
+	{
+	public:
+		explicit Timer( Kind kind ) : kind_( kind ), running_( enabled )
+		{
+			if ( running_ )
+			{
+				start_ = std::chrono::steady_clock::now();
+			}
+		}
+
+		~Timer()
+		{
+			if ( running_ )
+			{
+				Record( kind_, std::chrono::steady_clock::now() - start_ );
+			}
+		}
+
+	private:
+		static void Record( Kind kind, std::chrono::steady_clock::duration duration );
+
+		Kind kind_;
+		bool running_;
+		std::chrono::steady_clock::time_point start_;
+	};
+
+	/**
+	 * @brief To be called once per frame: turns profiling on or off, closes the
+	 *        per-frame counts and logs the report every logInterval seconds.
+	 */
+	void Frame( int time, bool enable, int logInterval );
+
+	void Reset();
+
+	// the sites with the most time spent, with at most maxSites lines
+	std::string Report( int maxSites );
+}
+
+#define TRACE_SITE \
+	( []( const char *function ) { static TraceProfile::Site site( __FILE__, __LINE__, function ); return &site; }( __func__ ) )
+
+// the site of this line, only looked up (and created) while profiling is on
+#define TRACE_PROFILE_SITE \
+	( TraceProfile::enabled ? TRACE_SITE : nullptr )
+
+// attributes the queries of the enclosing block to this line, e.g. for
+// queries made through function pointers
+#define TRACE_PROFILE_SCOPE() \
+	TraceProfile::SiteScope traceProfileScope( TRACE_PROFILE_SITE )
+
+// wraps a call to a query function to attribute it to the calling line
+#define TRACE_PROFILE_CALL( call ) \
+	( TraceProfile::SiteScope( TRACE_PROFILE_SITE ), call )
+
+#endif // SHARED_TRACE_PROFILE_H_
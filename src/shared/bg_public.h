@@ -1564,6 +1564,10 @@ bool     BG_IsMainStructure( buildable_t buildable );
 bool     BG_IsMainStructure( entityState_t *es );
 void     BG_MoveOriginToBBOXCenter( vec3_t point, const vec3_t mins, const vec3_t maxs );
 void     BG_MoveOriginToBBOXCenter( glm::vec3& point, glm::vec3 const& mins, glm::vec3 const& maxs );
+void     BG_BoxTraceAgainstBox( trace_t *trace, const vec3_t start, const vec3_t end,
+                                const vec3_t mins, const vec3_t maxs,
+                                const vec3_t boxMins, const vec3_t boxMaxs, const vec3_t boxOrigin,
+                                int brushmask, int skipmask );
 void     ModifyFlag(int &flags, int flag, bool value);
 void     AddFlag(int &flags, int flag);
 void     RemoveFlag(int &flags, int flag);
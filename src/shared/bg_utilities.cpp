@@ -151,6 +151,193 @@ void BG_MoveOriginToBBOXCenter( glm::vec3& point, glm::vec3 const& mins, glm::ve
 	point = point + ( maxs + mins ) * 0.5f;
 }
 
+/**
+ * @brief Sweeps an axis aligned box against a solid box, without going through
+ *        the generic BSP clipping code. Gives the same results as
+ *        CM_TransformedBoxTrace of an AABB trace against a non-capsule
+ *        CM_TempBoxModel( boxMins, boxMaxs ) with no rotation.
+ * @param trace Filled with the result, entityNum is left to the caller.
+ * @param mins, maxs Size of the moving box, may be nullptr for a point.
+ * @param boxMins, boxMaxs Bounds of the solid box, relative to boxOrigin.
+ */
+void BG_BoxTraceAgainstBox( trace_t *trace, const vec3_t start, const vec3_t end,
+                            const vec3_t mins, const vec3_t maxs,
+                            const vec3_t boxMins, const vec3_t boxMaxs, const vec3_t boxOrigin,
+                            int brushmask, int skipmask )
+{
+	// the collision code keeps traces that far from the surfaces they hit
+	const float SURFACE_CLIP_EPSILON = 0.125f;
+
+	// temporary box models are a single CONTENTS_BODY brush
+	const int boxContents = CONTENTS_BODY;
+
+	*trace = {};
+	trace->fraction = 1.0f;
+	trace->entityNum = ENTITYNUM_NONE;
+	VectorCopy( end, trace->endpos );
+
+	if ( !( brushmask & boxContents ) || ( skipmask & boxContents ) )
+	{
+		return;
+	}
+
+	if ( !mins )
+	{
+		mins = vec3_origin;
+	}
+
+	if ( !maxs )
+	{
+		maxs = vec3_origin;
+	}
+
+	// move to the box's frame, centering the moving box on its origin
+	vec3_t s, e, lo, hi;
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		float offset = ( mins[ i ] + maxs[ i ] ) * 0.5f;
+		lo[ i ] = mins[ i ] - offset;
+		hi[ i ] = maxs[ i ] - offset;
+		s[ i ] = start[ i ] + offset - boxOrigin[ i ];
+		e[ i ] = end[ i ] + offset - boxOrigin[ i ];
+	}
+
+	if ( VectorCompare( s, e ) )
+	{
+		// position test
+		for ( int i = 0; i < 3; i++ )
+		{
+			if ( s[ i ] + lo[ i ] > boxMaxs[ i ] || s[ i ] + hi[ i ] < boxMins[ i ] )
+			{
+				return;
+			}
+		}
+
+		trace->startsolid = trace->allsolid = true;
+		trace->fraction = 0.0f;
+		trace->contents = boxContents;
+		return;
+	}
+
+	float enterFrac = -1.0f;
+	float leaveFrac = 1.0f;
+	int   clipSide = -1;
+	bool  startout = false;
+	bool  getout = false;
+
+	// sides in the order of the box brush: +x, -x, +y, -y, +z, -z
+	for ( int side = 0; side < 6; side++ )
+	{
+		int   axis = side >> 1;
+		float d1, d2;
+
+		// distances to the side pushed out by the size of the moving box
+		if ( side & 1 )
+		{
+			float dist = -boxMins[ axis ] + hi[ axis ];
+			d1 = -s[ axis ] - dist;
+			d2 = -e[ axis ] - dist;
+		}
+		else
+		{
+			float dist = boxMaxs[ axis ] - lo[ axis ];
+			d1 = s[ axis ] - dist;
+			d2 = e[ axis ] - dist;
+		}
+
+		if ( d2 > 0 )
+		{
+			getout = true; // endpoint is not in solid
+		}
+
+		if ( d1 > 0 )
+		{
+			startout = true;
+		}
+
+		// if completely in front of face, no intersection with the entire box
+		if ( d1 > 0 && ( d2 >= SURFACE_CLIP_EPSILON || d2 >= d1 ) )
+		{
+			return;
+		}
+
+		// if it doesn't cross the plane, the plane isn't relevant
+		if ( d1 <= 0 && d2 <= 0 )
+		{
+			continue;
+		}
+
+		if ( d1 > d2 )
+		{
+			// enter
+			float f = std::max( ( d1 - SURFACE_CLIP_EPSILON ) / ( d1 - d2 ), 0.0f );
+
+			if ( f > enterFrac )
+			{
+				enterFrac = f;
+				clipSide = side;
+			}
+		}
+		else
+		{
+			// leave
+			float f = std::min( ( d1 + SURFACE_CLIP_EPSILON ) / ( d1 - d2 ), 1.0f );
+
+			if ( f < leaveFrac )
+			{
+				leaveFrac = f;
+			}
+		}
+	}
+
+	if ( !startout )
+	{
+		// original point was inside the box
+		trace->startsolid = true;
+
+		if ( !getout )
+		{
+			trace->allsolid = true;
+			trace->fraction = 0.0f;
+			trace->contents = boxContents;
+			VectorCopy( start, trace->endpos );
+		}
+
+		return;
+	}
+
+	if ( enterFrac < leaveFrac && enterFrac > -1 && enterFrac < 1.0f )
+	{
+		int axis = clipSide >> 1;
+
+		trace->fraction = std::max( enterFrac, 0.0f );
+		trace->contents = boxContents;
+
+		VectorClear( trace->plane.normal );
+
+		if ( clipSide & 1 )
+		{
+			trace->plane.normal[ axis ] = -1.0f;
+			trace->plane.dist = -boxMins[ axis ];
+			trace->plane.type = 3 + axis;
+		}
+		else
+		{
+			trace->plane.normal[ axis ] = 1.0f;
+			trace->plane.dist = boxMaxs[ axis ];
+			trace->plane.type = axis;
+		}
+
+		SetPlaneSignbits( &trace->plane );
+
+		for ( int i = 0; i < 3; i++ )
+		{
+			trace->endpos[ i ] = start[ i ] + trace->fraction * ( end[ i ] - start[ i ] );
+		}
+	}
+}
+
 void ModifyFlag(int &flags, int flag, bool value) {
 	if (value) {
 		flags |= flag;
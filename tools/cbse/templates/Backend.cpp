@@ -118,7 +118,7 @@ bool Entity::SendMessage(EntityMessage msg, const void* data) {
 
     {% endfor %}
 
-	std::set<{{component.get_type_name()}}*> {{component.get_base_type_name()}}::allSet;
+	ComponentPool<{{component.get_type_name()}}> {{component.get_base_type_name()}}::pool;
 
 {% endfor %}
 
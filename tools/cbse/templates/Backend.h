@@ -58,7 +58,8 @@
 #ifndef CBSE_BACKEND_H_
 #define CBSE_BACKEND_H_
 
-#include <set>
+#include <type_traits>
+#include <vector>
 
 #define CBSE_INCLUDE_TYPES_ONLY
 #include "../{{files['helper']}}"
@@ -188,21 +189,95 @@ class Entity {
 // Base component definitions //
 // ////////////////////////// //
 
+//* Pointers to all the instances of a component type are kept packed in an array, so that
+//* ForEntities is a linear walk; the instances themselves stay inside their entities. The walk
+//* goes in order of registration, shuffled by removals, not in address order. Each instance
+//* remembers its slot (its handle in the pool) so that it can be removed in O(1) by moving the
+//* last instance into the hole. While the pool is iterated, removals leave a null behind
+//* instead, and the holes are filled once the outermost iteration is over. Instances added
+//* during an iteration are appended and visited by it.
+/**
+ * @brief Dense storage of pointers to all the instances of a component type.
+ * @tparam C Type of component.
+ */
 template<typename C>
-class AllComponents {
+class ComponentPool {
 	public:
-		AllComponents(std::set<C*>& all): all(all) {}
+		/**
+		 * @brief Adds a component instance to the pool.
+		 * @return The slot of the instance, to be passed to Remove.
+		 */
+		int Add(C* component) {
+			dense.push_back(component);
+			return static_cast<int>(dense.size()) - 1;
+		}
+
+		/**
+		 * @brief Removes the component instance at the given slot.
+		 */
+		void Remove(int slot) {
+			if (iterating) {
+				dense[slot] = nullptr;
+				hasHoles = true;
+				return;
+			}
 
-		typename std::set<C*>::iterator begin() {
-			return all.begin();
+			size_t last = dense.size() - 1;
+
+			if (static_cast<size_t>(slot) != last) {
+				dense[slot] = dense[last];
+				dense[slot]->poolSlot = slot;
+			}
+
+			dense.pop_back();
 		}
 
-		typename std::set<C*>::iterator end() {
-			return all.end();
+		size_t Size() const {
+			return dense.size();
+		}
+
+		/**
+		 * @return The instance at the given slot, or nullptr if it was removed during iteration.
+		 */
+		C* operator[](size_t slot) const {
+			return dense[slot];
 		}
 
+		/** Marks the pool as being iterated for as long as it is alive. */
+		class Iteration {
+			public:
+				Iteration(ComponentPool& pool): pool(pool) {
+					pool.iterating++;
+				}
+
+				~Iteration() {
+					if (--pool.iterating == 0 && pool.hasHoles) {
+						pool.Compact();
+					}
+				}
+
+			private:
+				ComponentPool& pool;
+		};
+
 	private:
-		std::set<C*>& all;
+		void Compact() {
+			size_t kept = 0;
+
+			for (C* component : dense) {
+				if (component) {
+					component->poolSlot = static_cast<int>(kept);
+					dense[kept++] = component;
+				}
+			}
+
+			dense.resize(kept);
+			hasHoles = false;
+		}
+
+		std::vector<C*> dense;
+		int iterating = 0;
+		bool hasHoles = false;
 };
 
 {% for component in components %}
@@ -235,11 +310,11 @@ class AllComponents {
 				, {{name}}({{name}})
 			{%- endfor -%}
 			{
-				allSet.insert(reinterpret_cast<{{component.get_type_name()}}*>(this));
+				poolSlot = pool.Add(reinterpret_cast<{{component.get_type_name()}}*>(this));
 			}
 
 			~{{component.get_base_type_name()}}() {
-				allSet.erase(reinterpret_cast<{{component.get_type_name()}}*>(this));
+				pool.Remove(poolSlot);
 			}
 
 			{% for required in component.get_own_required_components() %}
@@ -261,8 +336,11 @@ class AllComponents {
 			/** A reference to the entity that owns the component instance. Allows sending back messages. */
 			Entity& entity;
 
-			static AllComponents<{{component.get_type_name()}}> GetAll() {
-				return {allSet};
+			/**
+			 * @return The pool of all the {{component.get_type_name()}} instances.
+			 */
+			static ComponentPool<{{component.get_type_name()}}>& GetPool() {
+				return pool;
 			}
 
 		protected:
@@ -275,7 +353,12 @@ class AllComponents {
 				{{declaration}}; /**< A component of the owning entity that this component depends on. */
 			{% endfor %}
 
-			static std::set<{{component.get_type_name()}}*> allSet;
+			template<typename C> friend class ComponentPool;
+
+			/** Slot of this instance in the pool. */
+			int poolSlot;
+
+			static ComponentPool<{{component.get_type_name()}}> pool;
 	};
 
 {% endfor %}
@@ -294,7 +377,17 @@ template <typename Component1, typename Component2, typename ... Components> boo
 
 template <typename Component1, typename ... Components, typename FuncType>
 void ForEntities(FuncType f) {
-    for(auto* component1: Component1::GetAll()) {
+    auto& pool = Component1::GetPool();
+    typename std::remove_reference<decltype(pool)>::type::Iteration iteration(pool);
+
+    //* The size is read again on each step, as the callback may add instances.
+    for (size_t slot = 0; slot < pool.Size(); slot++) {
+        Component1* component1 = pool[slot];
+
+        if (!component1) {
+            continue;
+        }
+
         Entity& ent = component1->entity;
 
         if (HasComponents<Component1, Components...>(ent)) {